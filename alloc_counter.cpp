@@ -0,0 +1,65 @@
+#include "alloc_counter.h"
+
+#if defined(AXE_COUNT_ALLOCS)
+
+#include <cstdlib> // malloc and free behind the counting operators.
+#include <new>     // std::bad_alloc and the nothrow tag.
+
+static thread_local uint64_t gThreadAllocations = 0;
+
+uint64_t ThreadAllocationCount() {
+    return gThreadAllocations;
+}
+
+static void* CountedAllocate(size_t size) {
+    ++gThreadAllocations;
+    return malloc(size ? size : 1);
+}
+
+void* operator new(size_t size) {
+    void* memory = CountedAllocate(size);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](size_t size) {
+    void* memory = CountedAllocate(size);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return CountedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return CountedAllocate(size);
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+    free(memory);
+}
+
+#else
+
+uint64_t ThreadAllocationCount() {
+    return 0;
+}
+
+#endif
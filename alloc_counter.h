@@ -0,0 +1,22 @@
+#ifndef AXE_GAME_ALLOC_COUNTER_H
+#define AXE_GAME_ALLOC_COUNTER_H
+
+// Debug counting of heap allocations, to check that steady-state frames never allocate.
+// When built with AXE_COUNT_ALLOCS (make COUNT_ALLOCS=1), alloc_counter.cpp replaces the global
+// operator new and counts every allocation per thread, so the worker threads (score writer,
+// leaderboard uploads, config watcher) do not disturb the main thread's numbers. Allocations made by C
+// libraries through malloc (raylib, GLFW) are not seen. Without the flag nothing is replaced and the
+// count is always zero.
+
+#include <cstdint> // uint64_t counter.
+
+#if defined(AXE_COUNT_ALLOCS)
+const bool kCountAllocations = true;
+#else
+const bool kCountAllocations = false;
+#endif
+
+// Number of operator new calls made so far by the calling thread.
+uint64_t ThreadAllocationCount();
+
+#endif // AXE_GAME_ALLOC_COUNTER_H
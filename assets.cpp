@@ -0,0 +1,354 @@
+#include "assets.h"
+
+#include <chrono>  // Upload time budget.
+#include <cstdint> // Fixed-width fields of the glyph metrics file.
+#include <cstdio>  // Cache and font files.
+#include <cstdlib> // malloc/free, compatible with raylib's UnloadFont.
+#include <cstring> // Magic comparisons.
+#include <string>  // Cache file names.
+#include <vector>  // File contents.
+
+// Glyph metrics file layout (all integers little-endian):
+//   "AXFA"  magic
+//   u16     format version (kGlyphCacheVersion)
+//   u16     font size in pixels
+//   u32     size of the source font file in bytes
+//   u32     FNV-1a hash of the source font file
+//   u32     glyph count
+//   ...     per glyph: i32 codepoint, i32 offsetX, i32 offsetY, i32 advanceX,
+//           then the atlas rectangle as four i32 (x, y, width, height)
+const uint16_t kGlyphCacheVersion = 1;
+const int kGlyphCount = 95;   // Printable ASCII, the same default set LoadFontEx uses.
+const int kAtlasPadding = 4;  // Pixels between glyphs, so filtering never bleeds into neighbours.
+
+static void PutU32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<uint8_t>(value >> shift));
+    }
+}
+
+static uint32_t GetU32(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+           (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+static bool ReadWholeFile(const std::string& path, std::vector<uint8_t>& bytes) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    uint8_t buffer[16384];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        bytes.insert(bytes.end(), buffer, buffer + read);
+    }
+    fclose(file);
+    return true;
+}
+
+static uint32_t Fnv1a(const std::vector<uint8_t>& bytes) {
+    uint32_t hash = 2166136261u;
+    for (uint8_t byte : bytes) {
+        hash = (hash ^ byte) * 16777619u;
+    }
+    return hash;
+}
+
+// Fill 'asset' from the cached atlas if the metrics file matches the font file. Returns false if
+// there is no usable cache, in which case 'asset' is unchanged.
+static bool LoadCachedAtlas(Asset& asset, const std::string& base, uint32_t sourceSize, uint32_t sourceHash) {
+    std::vector<uint8_t> metrics;
+    const size_t headerSize = 20;
+    const size_t glyphSize = 32;
+    if (!ReadWholeFile(base + ".glyphs", metrics) || metrics.size() < headerSize ||
+        memcmp(metrics.data(), "AXFA", 4) != 0) {
+        return false;
+    }
+    uint32_t versionAndSize = GetU32(metrics.data() + 4);
+    uint32_t glyphCount = GetU32(metrics.data() + 16);
+    if ((versionAndSize & 0xFFFF) != kGlyphCacheVersion || static_cast<int>(versionAndSize >> 16) != asset.fontSize ||
+        GetU32(metrics.data() + 8) != sourceSize || GetU32(metrics.data() + 12) != sourceHash ||
+        glyphCount > 4096 || metrics.size() != headerSize + glyphCount * glyphSize) {
+        return false; // Stale: the font, the size or the format changed since the cache was written.
+    }
+    std::string atlasPath = base + ".atlas.png";
+    if (!FileExists(atlasPath.c_str())) {
+        return false;
+    }
+    Image atlas = LoadImage(atlasPath.c_str());
+    if (!atlas.data) {
+        return false;
+    }
+
+    asset.glyphRecs = static_cast<Rectangle*>(malloc(sizeof(Rectangle) * glyphCount));
+    asset.glyphs = static_cast<CharInfo*>(calloc(glyphCount, sizeof(CharInfo)));
+    for (uint32_t i = 0; i < glyphCount; ++i) {
+        const uint8_t* glyph = metrics.data() + headerSize + i * glyphSize;
+        asset.glyphs[i].value = static_cast<int32_t>(GetU32(glyph));
+        asset.glyphs[i].offsetX = static_cast<int32_t>(GetU32(glyph + 4));
+        asset.glyphs[i].offsetY = static_cast<int32_t>(GetU32(glyph + 8));
+        asset.glyphs[i].advanceX = static_cast<int32_t>(GetU32(glyph + 12));
+        asset.glyphRecs[i] = Rectangle{static_cast<float>(static_cast<int32_t>(GetU32(glyph + 16))),
+                                       static_cast<float>(static_cast<int32_t>(GetU32(glyph + 20))),
+                                       static_cast<float>(static_cast<int32_t>(GetU32(glyph + 24))),
+                                       static_cast<float>(static_cast<int32_t>(GetU32(glyph + 28)))};
+    }
+    asset.glyphCount = static_cast<int>(glyphCount);
+    asset.image = atlas;
+    return true;
+}
+
+// Write the atlas and metrics of a freshly rasterized font. Failing to write is harmless: the font
+// is simply rasterized again next time.
+static void SaveCachedAtlas(const Asset& asset, const std::string& base, uint32_t sourceSize, uint32_t sourceHash) {
+    std::vector<uint8_t> metrics = {'A', 'X', 'F', 'A'};
+    PutU32(metrics, kGlyphCacheVersion | (static_cast<uint32_t>(asset.fontSize) << 16));
+    PutU32(metrics, sourceSize);
+    PutU32(metrics, sourceHash);
+    PutU32(metrics, static_cast<uint32_t>(asset.glyphCount));
+    for (int i = 0; i < asset.glyphCount; ++i) {
+        const CharInfo& glyph = asset.glyphs[i];
+        const Rectangle& rec = asset.glyphRecs[i];
+        const int32_t fields[8] = {glyph.value,
+                                   glyph.offsetX,
+                                   glyph.offsetY,
+                                   glyph.advanceX,
+                                   static_cast<int32_t>(rec.x),
+                                   static_cast<int32_t>(rec.y),
+                                   static_cast<int32_t>(rec.width),
+                                   static_cast<int32_t>(rec.height)};
+        for (int32_t field : fields) {
+            PutU32(metrics, static_cast<uint32_t>(field));
+        }
+    }
+
+    // The atlas goes first, so a metrics file never refers to an atlas that was not written.
+    ExportImage(asset.image, (base + ".atlas.png").c_str());
+    std::string metricsPath = base + ".glyphs";
+    std::string temporaryPath = metricsPath + ".tmp";
+    FILE* file = fopen(temporaryPath.c_str(), "wb");
+    if (!file) {
+        return;
+    }
+    bool written = fwrite(metrics.data(), 1, metrics.size(), file) == metrics.size();
+    written = fclose(file) == 0 && written;
+    remove(metricsPath.c_str()); // rename() does not replace an existing file on Windows.
+    if (!written || rename(temporaryPath.c_str(), metricsPath.c_str()) != 0) {
+        remove(temporaryPath.c_str());
+    }
+}
+
+static bool DecodeFont(Asset& asset) {
+    std::vector<uint8_t> source;
+    if (!ReadWholeFile(asset.path, source) || source.empty()) {
+        return false;
+    }
+    uint32_t sourceSize = static_cast<uint32_t>(source.size());
+    uint32_t sourceHash = Fnv1a(source);
+    std::string base = std::string(asset.path) + "." + std::to_string(asset.fontSize);
+    if (LoadCachedAtlas(asset, base, sourceSize, sourceHash)) {
+        return true;
+    }
+
+    // No cache: rasterize every glyph and pack them into one atlas, like LoadFontEx does.
+    CharInfo* glyphs = LoadFontData(asset.path, asset.fontSize, nullptr, kGlyphCount, FONT_DEFAULT);
+    if (!glyphs) {
+        return false;
+    }
+    Rectangle* recs = nullptr;
+    asset.image = GenImageFontAtlas(glyphs, &recs, kGlyphCount, asset.fontSize, kAtlasPadding, 0);
+    // The atlas now holds every glyph's pixels; drop the per-glyph copies.
+    for (int i = 0; i < kGlyphCount; ++i) {
+        UnloadImage(glyphs[i].image);
+        glyphs[i].image = Image{};
+    }
+    asset.glyphs = glyphs;
+    asset.glyphRecs = recs;
+    asset.glyphCount = kGlyphCount;
+    SaveCachedAtlas(asset, base, sourceSize, sourceHash);
+    return true;
+}
+
+void DecodeAsset(Asset& asset) {
+    bool ok = false;
+    if (FileExists(asset.path)) {
+        switch (asset.kind) {
+            case ASSET_TEXTURE:
+                asset.image = LoadImage(asset.path);
+                ok = asset.image.data != nullptr;
+                break;
+            case ASSET_FONT:
+                ok = DecodeFont(asset);
+                break;
+            case ASSET_WAVE:
+                asset.wave = LoadWave(asset.path);
+                ok = asset.wave.data != nullptr;
+                break;
+        }
+    }
+    // Release pairs with the acquire in Update(): the decoded data is visible before the state is.
+    asset.state.store(ok ? ASSET_DECODED : ASSET_FAILED, std::memory_order_release);
+}
+
+int AssetManager::Add(AssetKind kind, const char* path, int fontSize) {
+    if (count >= kMaxAssets) {
+        return -1;
+    }
+    Asset& asset = assets[count];
+    asset.kind = kind;
+    asset.path = path;
+    asset.fontSize = fontSize;
+    asset.state.store(ASSET_QUEUED);
+    return count++;
+}
+
+void AssetManager::LoadNow(int handle) {
+    if (handle < 0 || handle >= count || assets[handle].state.load() != ASSET_QUEUED) {
+        return;
+    }
+    DecodeAsset(assets[handle]);
+    if (assets[handle].state.load() == ASSET_DECODED) {
+        Upload(assets[handle]);
+    }
+}
+
+void AssetManager::StartStreaming() {
+#if !defined(PLATFORM_WEB)
+    if (!loader.joinable()) {
+        stopping = false;
+        loader = std::thread(&AssetManager::RunLoader, this);
+    }
+#endif
+}
+
+void AssetManager::RunLoader() {
+    // Registration is finished before the thread starts, so 'count' is stable here.
+    for (int i = 0; i < count; ++i) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) {
+                return;
+            }
+        }
+        if (assets[i].state.load() == ASSET_QUEUED) {
+            DecodeAsset(assets[i]);
+        }
+    }
+}
+
+bool AssetManager::Update(double budgetSeconds) {
+#if defined(PLATFORM_WEB)
+    // No loader thread: decode one asset per frame on the main thread.
+    while (nextToStream < count && assets[nextToStream].state.load() != ASSET_QUEUED) {
+        ++nextToStream;
+    }
+    if (nextToStream < count) {
+        DecodeAsset(assets[nextToStream++]);
+    }
+#endif
+    auto start = std::chrono::steady_clock::now();
+    bool changed = false;
+    for (int i = 0; i < count; ++i) {
+        if (assets[i].state.load(std::memory_order_acquire) != ASSET_DECODED) {
+            continue;
+        }
+        Upload(assets[i]);
+        changed = true;
+        if (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() > budgetSeconds) {
+            break; // The rest waits for the next frame.
+        }
+    }
+    return changed;
+}
+
+void AssetManager::Upload(Asset& asset) {
+    switch (asset.kind) {
+        case ASSET_TEXTURE:
+            asset.texture = LoadTextureFromImage(asset.image);
+            UnloadImage(asset.image);
+            asset.image = Image{};
+            break;
+        case ASSET_FONT:
+            asset.font.baseSize = asset.fontSize;
+            asset.font.charsCount = asset.glyphCount;
+            asset.font.texture = LoadTextureFromImage(asset.image);
+            asset.font.recs = asset.glyphRecs;
+            asset.font.chars = asset.glyphs;
+            UnloadImage(asset.image);
+            asset.image = Image{};
+            asset.glyphRecs = nullptr; // Owned by 'font' now.
+            asset.glyphs = nullptr;
+            break;
+        case ASSET_WAVE:
+            break; // Nothing to upload.
+    }
+    asset.state.store(ASSET_READY);
+}
+
+void AssetManager::StopLoader() {
+    if (!loader.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    loader.join(); // Waits for the asset being decoded at most.
+}
+
+void AssetManager::Unload() {
+    StopLoader();
+    for (int i = 0; i < count; ++i) {
+        Asset& asset = assets[i];
+        int state = asset.state.load();
+        if (state == ASSET_READY) {
+            if (asset.kind == ASSET_TEXTURE) {
+                UnloadTexture(asset.texture);
+            } else if (asset.kind == ASSET_FONT) {
+                UnloadFont(asset.font); // Also frees the malloc'd glyph arrays.
+            }
+        }
+        if (asset.kind == ASSET_WAVE && (state == ASSET_READY || state == ASSET_DECODED)) {
+            UnloadWave(asset.wave);
+        }
+        if (state == ASSET_DECODED) {
+            UnloadImage(asset.image);
+            free(asset.glyphRecs);
+            free(asset.glyphs);
+        }
+        asset.state.store(ASSET_QUEUED);
+        asset.texture = Texture2D{};
+        asset.font = Font{};
+        asset.wave = Wave{};
+        asset.image = Image{};
+        asset.glyphRecs = nullptr;
+        asset.glyphs = nullptr;
+    }
+    count = 0;
+    nextToStream = 0;
+}
+
+bool AssetManager::Ready(int handle, AssetKind kind) const {
+    return handle >= 0 && handle < count && assets[handle].kind == kind && assets[handle].state.load() == ASSET_READY;
+}
+
+const Texture2D* AssetManager::GetTexture(int handle) const {
+    return Ready(handle, ASSET_TEXTURE) ? &assets[handle].texture : nullptr;
+}
+
+const Font* AssetManager::GetFont(int handle) const {
+    return Ready(handle, ASSET_FONT) ? &assets[handle].font : nullptr;
+}
+
+const Wave* AssetManager::GetWave(int handle) const {
+    return Ready(handle, ASSET_WAVE) ? &assets[handle].wave : nullptr;
+}
+
+int AssetManager::Pending() const {
+    int pending = 0;
+    for (int i = 0; i < count; ++i) {
+        int state = assets[i].state.load();
+        pending += (state == ASSET_QUEUED || state == ASSET_DECODED) ? 1 : 0;
+    }
+    return pending;
+}
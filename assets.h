@@ -0,0 +1,104 @@
+#ifndef AXE_GAME_ASSETS_H
+#define AXE_GAME_ASSETS_H
+
+// Asset loading that keeps startup fast.
+// Everything the game needs is registered with Add() up front. The few assets the menu needs are
+// loaded right away with LoadNow(); StartStreaming() then hands the rest to a loader thread, which
+// does the slow part (reading files, decoding images and sounds, rasterizing fonts) while the menu is
+// already on screen. Uploading to the GPU has to happen on the thread that owns the OpenGL context,
+// so Update(), called once per frame, turns decoded assets into textures and fonts within a small
+// time budget. Until an asset is ready, its getter returns nullptr and callers keep using their
+// fallback (for fonts, raylib's built-in one).
+//
+// Rasterizing a TrueType font is by far the slowest load, so font atlases are cached on disk: the
+// first run writes the atlas as "<font>.<size>.atlas.png" plus the glyph metrics as
+// "<font>.<size>.glyphs", and later runs load those two files instead of the font, as long as the
+// font file is unchanged (its size and FNV-1a hash are stored in the metrics file).
+//
+// The web build has no threads; there, Update() decodes one queued asset per frame instead.
+
+#include "raylib.h"
+
+#include <atomic> // Per-asset state shared with the loader thread.
+#include <mutex>  // Guards the stop flag.
+#include <thread> // Loader thread.
+
+enum AssetKind {
+    ASSET_TEXTURE, // An image file, uploaded as a texture.
+    ASSET_FONT,    // A TrueType/OpenType font, rasterized at one size into a glyph atlas.
+    ASSET_WAVE     // A sound file, decoded into samples (CPU only; there is nothing to upload).
+};
+
+enum AssetState {
+    ASSET_QUEUED,  // Registered, not loaded yet.
+    ASSET_DECODED, // CPU-side data ready, waiting for Update() to upload it.
+    ASSET_READY,   // Usable.
+    ASSET_FAILED   // Missing or unreadable; callers keep their fallback.
+};
+
+const int kMaxAssets = 64;
+
+struct Asset {
+    AssetKind kind = ASSET_TEXTURE;
+    const char* path = nullptr;
+    int fontSize = 0;                       // ASSET_FONT only.
+    std::atomic<int> state{ASSET_QUEUED};   // An AssetState.
+
+    // CPU-side data, written by whoever decodes the asset before the state becomes ASSET_DECODED.
+    Image image = {};                       // Texture pixels or font atlas.
+    Rectangle* glyphRecs = nullptr;         // Font glyph rectangles in the atlas (malloc'd).
+    CharInfo* glyphs = nullptr;             // Font glyph metrics, without per-glyph images (malloc'd).
+    int glyphCount = 0;
+
+    // Usable results, only touched on the main thread.
+    Texture2D texture = {};
+    Font font = {};
+    Wave wave = {};
+};
+
+struct AssetManager {
+    // Register an asset and return its handle. Call before StartStreaming(). Returns -1 if full.
+    int Add(AssetKind kind, const char* path, int fontSize = 0);
+
+    // Load an asset completely on the calling (main) thread, e.g. for the menu's first frame.
+    void LoadNow(int handle);
+
+    // Load every asset not loaded yet in the background, in the order they were added.
+    void StartStreaming();
+
+    // Upload decoded assets, spending at most about 'budgetSeconds' per call. Call once per frame.
+    // Returns true if any asset became ready, so callers know when to swap in their real assets.
+    bool Update(double budgetSeconds = 0.002);
+
+    // Stop the loader and release everything. Needs the window (OpenGL context) still open.
+    void Unload();
+
+    ~AssetManager() { StopLoader(); }
+
+    // The asset if it is ready, otherwise nullptr.
+    const Texture2D* GetTexture(int handle) const;
+    const Font* GetFont(int handle) const;
+    const Wave* GetWave(int handle) const;
+
+    // Number of assets still queued or decoding.
+    int Pending() const;
+
+    // Internal state.
+    Asset assets[kMaxAssets];
+    int count = 0;
+    int nextToStream = 0;                   // Loader position; web builds decode from here in Update().
+    std::thread loader;
+    std::mutex mutex;
+    bool stopping = false;                  // Guarded by 'mutex'.
+
+    bool Ready(int handle, AssetKind kind) const;
+    void StopLoader();
+    void RunLoader();
+    void Upload(Asset& asset);
+};
+
+// Decode 'asset' on the calling thread (file reading and rasterizing only, no GPU calls) and set
+// its state to ASSET_DECODED or ASSET_FAILED. Fonts go through the on-disk atlas cache.
+void DecodeAsset(Asset& asset);
+
+#endif // AXE_GAME_ASSETS_H
@@ -0,0 +1,230 @@
+#include "audio_mixer.h"
+
+#include <chrono>  // Polling interval.
+#include <cmath>   // Synthesized clips and the burst gain.
+#include <cstdio>  // Clip paths and the no-device message.
+#include <cstring> // Clearing the mix buffer.
+
+// How often the audio thread checks whether the stream wants another chunk. Well under the time
+// one chunk plays for, so the stream never runs dry.
+const std::chrono::milliseconds kMixPollInterval(2);
+// A command for a sound that already started less than this long ago joins that voice.
+const uint64_t kRetriggerFrames = kMixSampleRate * 30 / 1000;
+// A burst of n events plays at base * (1 + kBurstGain * log2(n)), but never above kMaxBurstGain
+// times the base, so a wall of bounces is louder than one without drowning everything else.
+const float kBurstGain = 0.3f;
+const float kMaxBurstGain = 2.0f;
+
+// Per sound: the clip file, and the gain of a single event.
+struct SoundInfo {
+    const char* file;
+    float gain;
+};
+
+static const SoundInfo kSounds[SOUND_COUNT] = {
+    {"bounce.wav", 0.35f},
+    {"hit.wav", 0.8f},
+    {"speed_up.wav", 0.7f},
+};
+
+// Fallback clips, built from a few lines of math.
+static void SynthesizeClip(SoundId sound, SoundClip& clip) {
+    const float kPi = 3.14159265f;
+    const float rate = static_cast<float>(kMixSampleRate);
+    float seconds = sound == SOUND_BOUNCE ? 0.04f : (sound == SOUND_HIT ? 0.3f : 0.2f);
+    int length = static_cast<int>(seconds * rate);
+    clip.samples.resize(length);
+    uint32_t noise = 12345u;
+    float phase = 0.0f;
+    for (int i = 0; i < length; ++i) {
+        float t = i / rate;
+        float value;
+        if (sound == SOUND_BOUNCE) {
+            // A short, bright tick.
+            value = 0.5f * sinf(2.0f * kPi * 880.0f * t) * expf(-t / 0.01f);
+        } else if (sound == SOUND_HIT) {
+            // A thud: a burst of noise over a low tone.
+            noise = noise * 1664525u + 1013904223u;
+            float white = static_cast<float>(noise >> 8) / 8388608.0f - 1.0f;
+            value = 0.4f * white * expf(-t / 0.06f) + 0.4f * sinf(2.0f * kPi * 110.0f * t) * expf(-t / 0.12f);
+        } else {
+            // A rising chirp from 440 Hz to 1320 Hz.
+            phase += 2.0f * kPi * (440.0f + 880.0f * t / seconds) / rate;
+            value = 0.4f * sinf(phase) * sinf(kPi * t / seconds);
+        }
+        clip.samples[i] = static_cast<int16_t>(value * 32767.0f);
+    }
+}
+
+bool AudioMixer::Start(const char* directory) {
+    Stop();
+    clipDirectory = directory;
+    voiceCount = 0;
+    mixedFrames = 0;
+#if defined(PLATFORM_WEB)
+    LoadClips();
+    if (!OpenDevice()) {
+        return false;
+    }
+#else
+    stopping = false;
+    worker = std::thread(&AudioMixer::RunWorker, this);
+#endif
+    active = true;
+    return true;
+}
+
+void AudioMixer::Stop() {
+    if (!active) {
+        return;
+    }
+    active = false;
+#if defined(PLATFORM_WEB)
+    CloseDevice();
+#else
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+#endif
+}
+
+void AudioMixer::Update() {
+#if defined(PLATFORM_WEB)
+    if (active) {
+        Pump();
+    }
+#endif
+}
+
+void AudioMixer::RunWorker() {
+    LoadClips();
+    if (!OpenDevice()) {
+        // Play() keeps queueing until the ring is full and then counts drops; the game plays on
+        // without sound.
+        printf("audio: no output device, sounds disabled\n");
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        lock.unlock();
+        Pump();
+        lock.lock();
+        wake.wait_for(lock, kMixPollInterval, [this] { return stopping; });
+    }
+    lock.unlock();
+    CloseDevice();
+}
+
+bool AudioMixer::OpenDevice() {
+    InitAudioDevice();
+    if (!IsAudioDeviceReady()) {
+        return false;
+    }
+    SetAudioStreamBufferSizeDefault(kMixChunkFrames);
+    stream = InitAudioStream(kMixSampleRate, 16, 1);
+    deviceOpen = true;
+    Pump(); // Fill the stream before it starts, so it does not open with silence.
+    PlayAudioStream(stream);
+    return true;
+}
+
+void AudioMixer::CloseDevice() {
+    if (!deviceOpen) {
+        return;
+    }
+    CloseAudioStream(stream);
+    CloseAudioDevice();
+    deviceOpen = false;
+}
+
+void AudioMixer::LoadClips() {
+    for (uint32_t sound = 0; sound < SOUND_COUNT; ++sound) {
+        SoundClip& clip = clips[sound];
+        clip.samples.clear();
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", clipDirectory, kSounds[sound].file);
+        if (FileExists(path)) {
+            Wave wave = LoadWave(path);
+            if (wave.data) {
+                WaveFormat(&wave, kMixSampleRate, 16, 1); // Resampled and downmixed once, here.
+                const int16_t* samples = static_cast<const int16_t*>(wave.data);
+                clip.samples.assign(samples, samples + wave.sampleCount);
+                UnloadWave(wave);
+            }
+        }
+        if (clip.samples.empty()) {
+            SynthesizeClip(static_cast<SoundId>(sound), clip);
+        }
+    }
+}
+
+void AudioMixer::Apply(const SoundCommand& command) {
+    if (command.sound >= SOUND_COUNT) {
+        return;
+    }
+    float burst = 1.0f + kBurstGain * log2f(static_cast<float>(command.count));
+    float gain = kSounds[command.sound].gain * (burst < kMaxBurstGain ? burst : kMaxBurstGain);
+
+    // A retrigger right after the sound started only makes that voice louder.
+    for (int i = 0; i < voiceCount; ++i) {
+        Voice& voice = voices[i];
+        if (voice.sound == command.sound && mixedFrames - voice.startedAt < kRetriggerFrames) {
+            voice.gain = gain > voice.gain ? gain : voice.gain;
+            return;
+        }
+    }
+
+    int slot = voiceCount;
+    if (voiceCount == kMaxVoices) {
+        // Every voice is busy: replace the one closest to its end.
+        slot = 0;
+        for (int i = 1; i < voiceCount; ++i) {
+            if (voices[i].position > voices[slot].position) {
+                slot = i;
+            }
+        }
+    } else {
+        ++voiceCount;
+    }
+    voices[slot] = Voice{command.sound, 0, mixedFrames, gain};
+}
+
+void AudioMixer::Pump() {
+    SoundCommand command;
+    while (commands.TryPop(command)) {
+        Apply(command);
+    }
+    while (deviceOpen && IsAudioStreamProcessed(stream)) {
+        MixChunk();
+    }
+}
+
+void AudioMixer::MixChunk() {
+    memset(mixBuffer, 0, sizeof(mixBuffer));
+    for (int i = 0; i < voiceCount;) {
+        Voice& voice = voices[i];
+        const std::vector<int16_t>& samples = clips[voice.sound].samples;
+        uint32_t remaining = static_cast<uint32_t>(samples.size()) - voice.position;
+        uint32_t frames = remaining < kMixChunkFrames ? remaining : kMixChunkFrames;
+        const int16_t* source = samples.data() + voice.position;
+        for (uint32_t frame = 0; frame < frames; ++frame) {
+            mixBuffer[frame] += static_cast<int32_t>(source[frame] * voice.gain);
+        }
+        voice.position += frames;
+        if (voice.position >= samples.size()) {
+            voices[i] = voices[--voiceCount]; // Finished; the last voice takes its place.
+        } else {
+            ++i;
+        }
+    }
+    for (int frame = 0; frame < kMixChunkFrames; ++frame) {
+        int32_t value = mixBuffer[frame];
+        value = value > 32767 ? 32767 : (value < -32768 ? -32768 : value);
+        outputBuffer[frame] = static_cast<int16_t>(value);
+    }
+    UpdateAudioStream(stream, outputBuffer, kMixChunkFrames);
+    mixedFrames += kMixChunkFrames;
+}
@@ -0,0 +1,127 @@
+#ifndef AXE_GAME_AUDIO_MIXER_H
+#define AXE_GAME_AUDIO_MIXER_H
+
+// Sound effects.
+// Every clip is decoded once, when the mixer starts, into 16-bit mono PCM at the output rate, so
+// playing a sound never touches a file or a decoder. A dedicated audio thread owns the raylib
+// audio device and one output stream: whenever the stream has room for another chunk it mixes the
+// playing voices into it. The game thread only ever calls Play(), which copies a small command
+// into a lock-free single-producer ring (see spsc_ring.h) and returns; a full ring drops the
+// command rather than wait.
+//
+// Bursts are cheap on both sides. The game sends one command per sound per frame with a count
+// (every axe that bounced this frame), not one per event, and the mixer folds a command into a
+// voice of the same sound that started moments ago instead of starting another one, so thousands
+// of bounces in the bullet hell variant sound like a louder clatter and cost a handful of voices.
+//
+// Clips come from "<directory>/bounce.wav", "hit.wav" and "speed_up.wav" when those files exist,
+// converted to the mixer's format; any that is missing is synthesized instead, so the game always
+// has its sounds.
+//
+// The web build has no threads; there the device is opened on the main thread and Update(),
+// called once per frame, mixes whatever the stream needs.
+
+#include <atomic>             // Dropped-command counter.
+#include <condition_variable> // Waking the audio thread early on Stop().
+#include <cstdint>            // PCM samples and command fields.
+#include <mutex>              // Guards the stop flag.
+#include <thread>             // Audio thread.
+#include <vector>             // Decoded clips.
+
+#include "raylib.h"    // Audio device and stream.
+#include "spsc_ring.h" // The command queue.
+
+enum SoundId : uint32_t {
+    SOUND_BOUNCE,   // An axe or obstacle bounced off an edge.
+    SOUND_HIT,      // The player was hit.
+    SOUND_SPEED_UP, // The axes sped up.
+    SOUND_COUNT
+};
+
+// Output format, also the format every clip is decoded to.
+const int kMixSampleRate = 44100;
+// Samples mixed at a time. The stream double-buffers chunks, so this is also roughly the latency
+// from Play() to the speaker (about 23 ms).
+const int kMixChunkFrames = 1024;
+// Voices that can play at once; beyond that the one furthest along is replaced.
+const int kMaxVoices = 32;
+// Commands the ring holds. The game sends at most a few per frame.
+const int kSoundCommandRingSize = 256;
+
+// One Play() call as it travels through the ring.
+struct SoundCommand {
+    uint32_t sound; // A SoundId.
+    int32_t count;  // Events it stands for, e.g. bounces this frame.
+};
+
+// A decoded clip: mono samples at kMixSampleRate.
+struct SoundClip {
+    std::vector<int16_t> samples;
+};
+
+// A clip being played.
+struct Voice {
+    uint32_t sound;
+    uint32_t position;  // Next sample of the clip.
+    uint64_t startedAt; // Mixer sample clock when it started.
+    float gain;
+};
+
+struct AudioMixer {
+    // Open the audio device (on the audio thread) and decode the clips, looking for clip files in
+    // 'directory'. Returns false if the mixer could not be started; Play() then does nothing.
+    bool Start(const char* directory);
+
+    // Stop mixing and close the device. Called by the destructor.
+    void Stop();
+
+    ~AudioMixer() { Stop(); }
+
+    // True between a successful Start() and Stop().
+    bool Active() const { return active; }
+
+    // Play 'sound' for 'count' events at once; the more events, the louder (up to a limit). Never
+    // blocks. Game thread only.
+    void Play(SoundId sound, int count = 1) {
+        if (active && count > 0 && !commands.TryPush(SoundCommand{sound, count})) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Web builds: apply the queued commands and mix what the stream needs. Call once per frame; it
+    // does nothing where the audio thread does the mixing.
+    void Update();
+
+    // Commands lost to a full ring so far.
+    uint32_t Dropped() const { return dropped.load(std::memory_order_relaxed); }
+
+    // Internal state. Everything below 'dropped' belongs to whichever thread mixes.
+    SpscRing<SoundCommand, kSoundCommandRingSize> commands;
+    bool active = false;          // Only read and written by the game thread.
+    std::atomic<uint32_t> dropped{0};
+    const char* clipDirectory = nullptr;
+
+    SoundClip clips[SOUND_COUNT];
+    Voice voices[kMaxVoices];
+    int voiceCount = 0;
+    uint64_t mixedFrames = 0;     // Sample clock: samples handed to the stream so far.
+    AudioStream stream = {};
+    bool deviceOpen = false;
+    int32_t mixBuffer[kMixChunkFrames];
+    int16_t outputBuffer[kMixChunkFrames];
+
+    std::thread worker;
+    std::mutex mutex;             // Guards 'stopping'.
+    std::condition_variable wake; // Signalled by Stop().
+    bool stopping = false;
+
+    bool OpenDevice();
+    void CloseDevice();
+    void LoadClips();
+    void Apply(const SoundCommand& command);
+    void Pump();
+    void MixChunk();
+    void RunWorker();
+};
+
+#endif // AXE_GAME_AUDIO_MIXER_H
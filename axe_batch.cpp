@@ -0,0 +1,163 @@
+// Multithreaded batch simulator for difficulty tuning.
+// Plays N independent headless games across every core and reports how long the player survives: mean and percentiles, plus a per-second histogram of survival times as CSV. Each worker
+// owns its World and its histogram, so the hot loop touches no shared mutable state; the per-worker
+// results are only merged once at the end.
+//
+// Usage: axe_batch [games] [threads] [seed] [axes] [histogram.csv] [player]
+//   games   At least 1 (default 100000).
+//   threads 0 (the default) uses one worker per hardware thread.
+//   axes    1 to kMaxBatchAxes (default 1).
+//   histogram.csv  "-" skips the CSV.
+//   player  "script" (the default) for the random scripted player, "bot" for the DodgeBot.
+
+#include "controller.h"
+#include "dodge_bot.h"
+#include "scripted_player.h"
+#include "simulation.h"
+#include "thread_pool.h"
+
+#include <chrono>  // Wall-clock timing of the whole run.
+#include <climits> // Argument ranges.
+#include <cstdio>  // Summary and CSV output.
+#include <cstdlib> // Command-line parsing.
+#include <cstring> // strcmp for the player name.
+#include <vector>  // Per-worker state.
+
+// Upper bound on the length of a single game (one hour of game time).
+const int kMaxTicksPerGame = kTickRate * 60 * 60;
+// Survival histogram resolution: one bin per second of survival, the last bin collects the rest.
+const int kSurvivalBins = 600;
+// Most axes per game. Every worker reserves a pool this big, so the limit keeps a typo from
+// exhausting memory.
+const long long kMaxBatchAxes = 1000000;
+// Games per task. Large enough to amortize scheduling, small enough to balance the load.
+const long long kGamesPerTask = 256;
+
+// Everything one worker needs. The states sit side by side in a std::vector, which does not
+// over-align its elements under C++14, so the trailing padding (a whole cache line) is what keeps
+// the counters one worker bumps per game off the line the next worker's state starts on.
+struct WorkerState {
+    World world;                        // Reused for every game this worker plays.
+    DodgeBot bot;                       // Likewise, if the bot plays.
+    std::vector<long long> survivalBins; // Games that survived [i, i+1) seconds.
+    long long games = 0;
+    long long ticks = 0;
+    int longestTicks = 0;
+    char padding[64];
+};
+
+// Parse argv[index] as a whole number in [minimum, maximum], or keep 'value' if the argument is
+// absent. Returns false if the argument is not such a number.
+static bool ParseArgument(int argc, char** argv, int index, long long minimum, long long maximum, long long& value) {
+    if (index >= argc) {
+        return true;
+    }
+    char* end = nullptr;
+    value = strtoll(argv[index], &end, 10);
+    return end != argv[index] && *end == '\0' && value >= minimum && value <= maximum;
+}
+
+int main(int argc, char** argv) {
+    long long games = 100000;
+    long long threads = 0;
+    long long seedArgument = 1;
+    long long axes = 1;
+    const char* csvPath = (argc > 5 && strcmp(argv[5], "-") != 0) ? argv[5] : nullptr;
+    bool useBot = argc > 6 && strcmp(argv[6], "bot") == 0;
+    if (!ParseArgument(argc, argv, 1, 1, LLONG_MAX, games) || !ParseArgument(argc, argv, 2, 0, INT_MAX, threads) ||
+        !ParseArgument(argc, argv, 3, 0, UINT32_MAX, seedArgument) ||
+        !ParseArgument(argc, argv, 4, 1, kMaxBatchAxes, axes) ||
+        (argc > 6 && !useBot && strcmp(argv[6], "script") != 0) || argc > 7) {
+        printf("usage: axe_batch [games>=1] [threads] [seed] [axes>=1] [histogram.csv|-] [script|bot]\n");
+        return 1;
+    }
+    int threadCount = static_cast<int>(threads);
+    uint32_t seed = static_cast<uint32_t>(seedArgument);
+    int axeCount = static_cast<int>(axes);
+
+    ThreadPool pool(threadCount);
+    std::vector<WorkerState> states(pool.Size());
+    for (WorkerState& state : states) {
+        state.survivalBins.assign(kSurvivalBins, 0);
+        state.world.Reset(axeCount); // Allocate the axe and bot storage before the clock starts.
+        state.bot.Reserve(axeCount + state.world.config.spinningAxes + state.world.config.homingAxes);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    pool.ParallelFor(games, kGamesPerTask, [&](long long begin, long long end, int worker) {
+        WorkerState& state = states[worker];
+        for (long long game = begin; game < end; ++game) {
+            // Seeds depend only on the game index, so results do not depend on the thread count.
+            uint32_t gameSeed = seed + static_cast<uint32_t>(game) * 2654435761u;
+            state.world.Reset(axeCount, gameSeed);
+            ScriptedPlayer script(gameSeed ^ 0x9E3779B9u);
+            state.bot.Reset();
+            Controller player = useBot ? MakeController("bot", state.bot) : MakeController("script", script);
+
+            int tick = 0;
+            while (tick < kMaxTicksPerGame) {
+                ++tick;
+                if (state.world.Step(kTickSeconds, player.Next(state.world))) {
+                    break;
+                }
+            }
+
+            int bin = tick / kTickRate;
+            state.survivalBins[bin < kSurvivalBins ? bin : kSurvivalBins - 1] += 1;
+            state.games += 1;
+            state.ticks += tick;
+            state.longestTicks = tick > state.longestTicks ? tick : state.longestTicks;
+        }
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Merge the per-worker results.
+    std::vector<long long> survivalBins(kSurvivalBins, 0);
+    long long totalGames = 0;
+    long long totalTicks = 0;
+    int longestTicks = 0;
+    for (const WorkerState& state : states) {
+        for (int bin = 0; bin < kSurvivalBins; ++bin) {
+            survivalBins[bin] += state.survivalBins[bin];
+        }
+        totalGames += state.games;
+        totalTicks += state.ticks;
+        longestTicks = state.longestTicks > longestTicks ? state.longestTicks : longestTicks;
+    }
+
+    // Percentiles at whole-second resolution, straight from the histogram.
+    auto percentile = [&](double p) {
+        if (totalGames == 0) {
+            return 0;
+        }
+        long long target = static_cast<long long>(p / 100.0 * totalGames);
+        long long seen = 0;
+        for (int bin = 0; bin < kSurvivalBins; ++bin) {
+            seen += survivalBins[bin];
+            if (seen > target) {
+                return bin;
+            }
+        }
+        return kSurvivalBins - 1;
+    };
+
+    printf("games=%lld threads=%d axes=%d seconds=%.3f games_per_sec=%.0f\n", totalGames, pool.Size(), axeCount,
+           seconds, seconds > 0.0 ? totalGames / seconds : 0.0);
+    printf("survival_mean_s=%.2f p50_s=%d p90_s=%d p99_s=%d max_s=%.2f\n",
+           totalGames ? static_cast<double>(totalTicks) / totalGames / kTickRate : 0.0, percentile(50.0),
+           percentile(90.0), percentile(99.0), static_cast<double>(longestTicks) / kTickRate);
+
+    if (csvPath) {
+        FILE* file = fopen(csvPath, "w");
+        if (!file) {
+            printf("%s: cannot write histogram\n", csvPath);
+            return 1;
+        }
+        fprintf(file, "survival_s,games\n");
+        for (int bin = 0; bin < kSurvivalBins; ++bin) {
+            fprintf(file, "%d,%lld\n", bin, survivalBins[bin]);
+        }
+        fclose(file);
+    }
+    return 0;
+}
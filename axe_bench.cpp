@@ -0,0 +1,231 @@
+// Microbenchmarks for the simulation and collision hot paths.
+// Prints one JSON object per line so results can be collected by scripts and compared between
+// releases. The first line describes the machine and build, every later line is one benchmark:
+//   {"bench":"axe_move","variant":"avx2","n":100000,"iterations":1200,"ns_per_op":0.41,"ops_per_sec":2.4e+09}
+// "n" is the number of items processed per iteration and "ns_per_op" is the time per item
+// (per axe, per collision test, or per tick for the end-to-end benchmarks).
+//
+// Usage: axe_bench [min_seconds] [filter]
+//   min_seconds  Minimum measuring time per benchmark, above 0 (default 0.2).
+//   filter       Only run benchmarks whose name contains this text, e.g. "world_step".
+
+#include "axe_grid.h"
+#include "axe_kernels.h"
+#include "axe_pool.h"
+#include "build_profile.h"
+#include "scripted_player.h"
+#include "simulation.h"
+
+#include <chrono>  // Timing.
+#include <cmath>   // Validating min_seconds.
+#include <cstdio>  // JSON output.
+#include <cstdlib> // Command-line parsing.
+#include <cstring> // strstr for the filter.
+#include <vector>  // Benchmark data.
+
+static double gMinSeconds = 0.2;
+static const char* gFilter = nullptr;
+
+// Results flow into here so the optimizer cannot drop the benchmarked work.
+static volatile float gSink = 0.0f;
+
+// Run 'body' (which processes 'itemsPerCall' items) until at least gMinSeconds have passed,
+// doubling the number of calls per timing batch, then print the result as one JSON line. At least
+// one batch is always timed, so the line never divides by zero calls.
+template <typename Body>
+static void Run(const char* name, const char* variant, long long itemsPerCall, Body body) {
+    if (gFilter && !strstr(name, gFilter)) {
+        return;
+    }
+    typedef std::chrono::steady_clock Clock;
+    body(); // Warm up caches and any lazy initialization.
+    long long calls = 0;
+    long long batch = 1;
+    double seconds = 0.0;
+    do {
+        Clock::time_point start = Clock::now();
+        for (long long i = 0; i < batch; ++i) {
+            body();
+        }
+        seconds += std::chrono::duration<double>(Clock::now() - start).count();
+        calls += batch;
+        batch *= 2;
+    } while (seconds < gMinSeconds);
+    double items = static_cast<double>(calls) * itemsPerCall;
+    printf("{\"bench\":\"%s\",\"variant\":\"%s\",\"n\":%lld,\"iterations\":%lld,\"ns_per_op\":%.4f,"
+           "\"ops_per_sec\":%.4g}\n",
+           name, variant, itemsPerCall, calls, seconds * 1e9 / items, items / seconds);
+    fflush(stdout);
+}
+
+// Axes scattered over the playfield the same way World::Reset scatters bullet hell axes. With a
+// 'clearance' above 0, no axe comes within that distance of the playfield's center.
+static void FillPool(AxePool& pool, int count, const GameConfig& config, float clearance = 0.0f) {
+    pool.Reserve(count);
+    pool.Clear();
+    Rng rng(42u);
+    float cx = config.screenWidth / 2.0f;
+    float cy = config.screenHeight / 2.0f;
+    for (int i = 0; i < count; ++i) {
+        float x;
+        float y;
+        do {
+            x = rng.NextFloat() * (config.screenWidth - config.axeLength);
+            y = rng.NextFloat() * (config.screenHeight - config.axeLength);
+        } while (clearance > 0.0f && x < cx + clearance && x + config.axeLength > cx - clearance &&
+                 y < cy + clearance && y + config.axeLength > cy - clearance);
+        float vx = (rng.Next() & 1) ? config.axeStartSpeedX : -config.axeStartSpeedX;
+        float vy = (rng.Next() & 1) ? config.axeStartSpeedY : -config.axeStartSpeedY;
+        pool.Spawn(x, y, vx, vy, static_cast<float>(config.axeLength));
+    }
+}
+
+static void BenchAxeMove(const GameConfig& config, int count) {
+    AxePool pool;
+    FillPool(pool, count, config);
+
+    // The original representation: one Axe struct per obstacle, moved one at a time by value.
+    std::vector<Axe> structs;
+    for (int i = 0; i < count; ++i) {
+        structs.push_back(pool.Get(i));
+    }
+    Run("axe_move", "struct", count, [&]() {
+        for (Axe& axe : structs) {
+            axe.Move(config.screenWidth, config.screenHeight, kTickSeconds);
+        }
+        gSink = structs[0].x;
+    });
+
+    // The structure-of-arrays pool through every batch kernel this CPU can run.
+    const char* kernels[] = {"scalar", "sse2", "avx2", "neon"};
+    for (const char* name : kernels) {
+        const AxeKernel* kernel = FindAxeKernel(name);
+        if (!kernel) {
+            continue;
+        }
+        int lanes = (pool.highWater + kAxeLaneWidth - 1) / kAxeLaneWidth * kAxeLaneWidth;
+        AxeArrays arrays = {pool.x.data(),      pool.y.data(),     pool.vx.data(),    pool.vy.data(),
+                            pool.length.data(), pool.prevX.data(), pool.prevY.data(), lanes};
+        Run("axe_move", name, count, [&]() {
+            kernel->move(arrays, static_cast<float>(config.screenWidth), static_cast<float>(config.screenHeight),
+                         kTickSeconds);
+            gSink = pool.x[0];
+        });
+    }
+}
+
+static void BenchPlayerMove(const GameConfig& config) {
+    const int kMoves = 1024;
+    Player player = {config.screenWidth / 2.0f, config.screenHeight / 2.0f, config.playerRadius, 0.0f, 0.0f};
+    // A scripted input sequence, pre-generated so the benchmark times Move() and not the script.
+    std::vector<InputMask> inputs;
+    ScriptedPlayer script(7u);
+    for (int i = 0; i < kMoves; ++i) {
+        inputs.push_back(script.Next());
+    }
+    Run("player_move", "struct", kMoves, [&]() {
+        for (InputMask input : inputs) {
+            player.Move(config.screenWidth, config.screenHeight, config.playerSpeed, kTickSeconds, input);
+        }
+        gSink = player.x;
+    });
+    // The same moves within the arcade profile's compile-time bounds (see build_profile.h).
+    const auto arcadeBounds = ArcadeProfile::Bounds(config);
+    Run("player_move", "fixed", kMoves, [&]() {
+        for (InputMask input : inputs) {
+            player.MoveWithin(arcadeBounds, ArcadeProfile::kPlayerSpeed, kTickSeconds, input);
+        }
+        gSink = player.x;
+    });
+}
+
+static void BenchCollision(const GameConfig& config, int count) {
+    // The player sits in the middle of the playfield and no axe touches it, so neither variant can
+    // stop at a hit: both do the full work of a tick in which the player survives.
+    float cx = config.screenWidth / 2.0f;
+    float cy = config.screenHeight / 2.0f;
+    float speed = config.playerSpeed * kTickSeconds;
+    float axeStep = (config.axeStartSpeedX > config.axeStartSpeedY ? config.axeStartSpeedX : config.axeStartSpeedY) *
+                    kTickSeconds;
+    AxePool pool;
+    FillPool(pool, count, config, config.playerRadius + 2.0f * speed + 2.0f * axeStep);
+    pool.Move(static_cast<float>(config.screenWidth), static_cast<float>(config.screenHeight), kTickSeconds);
+    Player player = {cx, cy, config.playerRadius, cx - speed, cy - speed};
+
+    // Brute force: every axe as a standalone struct through the swept CheckCollision.
+    std::vector<Axe> structs;
+    for (int i = 0; i < count; ++i) {
+        structs.push_back(pool.Get(i));
+    }
+    gSink = 0.0f;
+    Run("check_collision", "struct", count, [&]() {
+        int hits = 0;
+        for (const Axe& axe : structs) {
+            hits += CheckCollision(player, axe) ? 1 : 0;
+        }
+        gSink = static_cast<float>(hits);
+    });
+    if (gSink != 0.0f) {
+        fprintf(stderr, "check_collision: the player touches an axe, the numbers below do not compare\n");
+    }
+
+    // The broad phase grid the game uses: only nearby axes reach the exact test. Reported per axe
+    // in play, like the brute force loop; with no hit to stop at, both numbers are the cost of one
+    // whole collision query divided by the axe count, so they compare directly.
+    AxeGrid grid;
+    grid.Init(config.screenWidth, config.screenHeight, pool.capacity);
+    grid.Update(pool);
+    Run("check_collision", "grid", count, [&]() {
+        int hit = grid.FindCollision(pool, player.prevX, player.prevY, player.x, player.y,
+                                     static_cast<float>(player.radius), kTickSeconds);
+        gSink = static_cast<float>(hit);
+    });
+}
+
+// Full World::Step throughput: player, axes, grid, scoring and collision. Hits are cleared after
+// every tick so each one does the full amount of work instead of returning early.
+static void BenchWorldStep(const GameConfig& config, int axeCount) {
+    World world;
+    world.config = config;
+    world.Reset(axeCount, 1234u);
+    ScriptedPlayer script(99u);
+    const int kTicks = axeCount >= 10000 ? 16 : 1024;
+    char variant[32];
+    snprintf(variant, sizeof(variant), "%d_axes", axeCount);
+    Run("world_step", variant, kTicks, [&]() {
+        for (int tick = 0; tick < kTicks; ++tick) {
+            world.Step(kTickSeconds, script.Next());
+            world.collided = false;
+        }
+        gSink = world.player.x;
+    });
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        char* end = nullptr;
+        gMinSeconds = strtod(argv[1], &end);
+        if (end == argv[1] || *end != '\0' || !(gMinSeconds > 0.0) || !std::isfinite(gMinSeconds)) {
+            printf("usage: axe_bench [min_seconds] [filter]\n");
+            return 1;
+        }
+    }
+    if (argc > 2) {
+        gFilter = argv[2];
+    }
+
+    GameConfig config;
+    printf("{\"bench\":\"meta\",\"kernel\":\"%s\",\"tick_rate\":%d,\"config_hash\":%u,\"min_seconds\":%.3f}\n",
+           SelectAxeKernel().name, kTickRate, SimulationConfigHash(config), gMinSeconds);
+
+    BenchAxeMove(config, 1024);
+    BenchAxeMove(config, 100000);
+    BenchPlayerMove(config);
+    BenchCollision(config, 1);
+    BenchCollision(config, 10000);
+    const int axeCounts[] = {1, 100, 10000, 100000};
+    for (int axeCount : axeCounts) {
+        BenchWorldStep(config, axeCount);
+    }
+    return 0;
+}
@@ -0,0 +1,371 @@
+// Offline replay capture: turns a recorded game into an animated GIF to share.
+// Capturing never touches the game itself. The replay is re-simulated with the headless simulation
+// core, exactly as axe_verify does, and at each output frame the positions of the player and every
+// obstacle are copied into a snapshot. Snapshots are drawn by a small software rasterizer into
+// palette images and LZW-compressed into GIF frame blocks on a work-stealing thread pool, one frame
+// per task with one canvas per worker, and the blocks are written to the file in frame order. The
+// whole pipeline runs far faster than real time and needs no window, GPU or raylib.
+//
+// The picture matches the game's: the same playfield, colors and shapes, with the score in the top
+// left corner and the axe that hit the player outlined on the last frame, which is held for two
+// seconds before the GIF loops.
+//
+// Usage: axe_capture [-j threads] [--fps N] [--scale X] [--config FILE] REPLAY OUT.gif
+//   -j threads      Encoder threads; 0 (the default) uses one per hardware thread.
+//   --fps N         Frames per second of game time, 1 to 50 (default 30).
+//   --scale X       Size of the GIF relative to the playfield, e.g. 0.5 for half (default 1).
+//   --config FILE   Simulate under the rules in this tuning file instead of the built-in defaults;
+//                   use the file the game was played with.
+// Exit code: 0 if the GIF was written, 1 otherwise.
+
+#include "game_config.h" // Optional tuning file.
+#include "gif_encoder.h" // GIF frame compression.
+#include "obstacles.h"   // Components of the other obstacle types.
+#include "replay.h"      // Replay decoding.
+#include "simulation.h"  // World.
+#include "thread_pool.h" // Parallel rasterizing and encoding.
+
+#include <chrono>  // Throughput timing.
+#include <cmath>   // floorf for pixel snapping.
+#include <cstdio>  // Output file and the report.
+#include <cstdlib> // Command-line parsing.
+#include <cstring> // Option names.
+#include <string>  // Config error messages.
+#include <vector>  // Snapshots, canvases and encoded frames.
+
+// Palette indices. The colors are raylib's, as the game uses them.
+enum CaptureColor : uint8_t {
+    CAPTURE_BACKGROUND, // WHITE
+    CAPTURE_PLAYER,     // PURPLE
+    CAPTURE_AXE,        // RED
+    CAPTURE_SPINNING,   // MAROON
+    CAPTURE_HOMING,     // ORANGE
+    CAPTURE_OUTLINE,    // BLACK: the axe that hit the player, and the score.
+    CAPTURE_COLOR_COUNT
+};
+
+static const GifColor kCapturePalette[CAPTURE_COLOR_COUNT] = {
+    {255, 255, 255}, {200, 122, 255}, {230, 41, 55}, {190, 33, 55}, {255, 161, 0}, {0, 0, 0},
+};
+
+// The last frame stays up this long before the GIF starts over.
+const int kFinalHoldCentiseconds = 200;
+// Output frames snapshotted per batch, per encoder thread. Enough to keep every thread busy while
+// bounding how many snapshots and encoded frames are held at once.
+const int kFramesPerThread = 4;
+
+// 3x5 pixel digits for the score, one row per entry; bit 2 is the left column.
+static const uint8_t kDigitRows[10][5] = {
+    {7, 5, 5, 5, 7}, {2, 6, 2, 2, 7}, {7, 1, 7, 4, 7}, {7, 1, 7, 1, 7}, {5, 5, 7, 1, 1},
+    {7, 4, 7, 1, 7}, {7, 4, 7, 5, 7}, {7, 1, 1, 1, 1}, {7, 5, 7, 5, 7}, {7, 5, 7, 1, 7},
+};
+const int kDigitPixelSize = 3; // Screen pixels per font pixel, before --scale.
+
+// One square obstacle as it is drawn: its top-left corner and side, rotated by (c, s) about its
+// center (c = 1, s = 0 when it does not spin). Outlines are drawn as a one pixel frame instead.
+struct CaptureSquare {
+    float x;
+    float y;
+    float length;
+    float c;
+    float s;
+    uint8_t color;
+    bool outline;
+};
+
+// Everything one output frame shows, copied out of the world so it can be drawn on another thread.
+struct FrameSnapshot {
+    float playerX;
+    float playerY;
+    float playerRadius;
+    int score;
+    int delayCentiseconds;
+    std::vector<CaptureSquare> squares;
+    std::vector<uint8_t> encoded; // The GIF frame block, filled in by the encoder.
+};
+
+// A worker's drawing surface. The workers sit side by side in a std::vector, which does not
+// over-align its elements under C++14, so the trailing padding (a whole cache line) is what keeps
+// one worker's canvas pointer off the line the next worker's starts on.
+struct CaptureWorker {
+    std::vector<uint8_t> canvas;
+    char padding[64];
+};
+
+static void Snapshot(World& world, FrameSnapshot& frame) {
+    frame.playerX = world.player.x;
+    frame.playerY = world.player.y;
+    frame.playerRadius = world.player.radius;
+    frame.score = world.score;
+    frame.squares.clear();
+    const AxePool& axes = world.axes;
+    for (int slot = 0; slot < axes.highWater; ++slot) {
+        if (axes.alive[slot]) {
+            frame.squares.push_back(
+                CaptureSquare{axes.x[slot], axes.y[slot], axes.length[slot], 1.0f, 0.0f, CAPTURE_AXE, false});
+        }
+    }
+    world.obstacles.Each<Position, Extent, Orientation>(
+        [&](const Position& position, const Extent& extent, const Orientation& orientation) {
+            frame.squares.push_back(CaptureSquare{position.x, position.y, extent.length, orientation.cos,
+                                                  orientation.sin, CAPTURE_SPINNING, false});
+        });
+    world.obstacles.Each<Position, Extent>(
+        [&](const Position& position, const Extent& extent) {
+            frame.squares.push_back(
+                CaptureSquare{position.x, position.y, extent.length, 1.0f, 0.0f, CAPTURE_HOMING, false});
+        },
+        MaskOfTypes<Orientation>());
+
+    // Outline whatever hit the player, like the game over screen does.
+    if (world.collided && world.hitAxe >= 0) {
+        Axe hit = world.axes.Get(world.hitAxe);
+        frame.squares.push_back(CaptureSquare{hit.x, hit.y, hit.length, 1.0f, 0.0f, CAPTURE_OUTLINE, true});
+    } else if (world.collided) {
+        const Position* hit = world.obstacles.Get<Position>(world.hitObstacle);
+        const Extent* extent = world.obstacles.Get<Extent>(world.hitObstacle);
+        if (hit && extent) {
+            frame.squares.push_back(CaptureSquare{hit->x, hit->y, extent->length, 1.0f, 0.0f, CAPTURE_OUTLINE, true});
+        }
+    }
+}
+
+// The software rasterizer. Pixel (px, py) covers [px, px + 1) x [py, py + 1) and is filled if its
+// center is inside the shape, which matches raylib's pixel-snapped rectangles and circles closely
+// enough for a GIF.
+struct Canvas {
+    uint8_t* pixels;
+    int width;
+    int height;
+    float scale; // Canvas pixels per playfield pixel.
+
+    void FillRect(int x0, int y0, int x1, int y1, uint8_t color) {
+        x0 = x0 < 0 ? 0 : x0;
+        y0 = y0 < 0 ? 0 : y0;
+        x1 = x1 > width ? width : x1;
+        y1 = y1 > height ? height : y1;
+        for (int y = y0; y < y1; ++y) {
+            for (int x = x0; x < x1; ++x) {
+                pixels[y * width + x] = color;
+            }
+        }
+    }
+
+    int Snap(float position) const { return static_cast<int>(floorf(position * scale + 0.5f)); }
+
+    void Circle(float centerX, float centerY, float radius, uint8_t color) {
+        float cx = centerX * scale;
+        float cy = centerY * scale;
+        float r = radius * scale;
+        int x0 = static_cast<int>(floorf(cx - r));
+        int x1 = static_cast<int>(floorf(cx + r)) + 1;
+        int y0 = static_cast<int>(floorf(cy - r));
+        int y1 = static_cast<int>(floorf(cy + r)) + 1;
+        for (int y = y0 < 0 ? 0 : y0; y < (y1 > height ? height : y1); ++y) {
+            float dy = y + 0.5f - cy;
+            for (int x = x0 < 0 ? 0 : x0; x < (x1 > width ? width : x1); ++x) {
+                float dx = x + 0.5f - cx;
+                if (dx * dx + dy * dy <= r * r) {
+                    pixels[y * width + x] = color;
+                }
+            }
+        }
+    }
+
+    void Square(const CaptureSquare& square) {
+        if (square.outline) {
+            int x0 = Snap(square.x);
+            int y0 = Snap(square.y);
+            int x1 = Snap(square.x + square.length);
+            int y1 = Snap(square.y + square.length);
+            FillRect(x0, y0, x1, y0 + 1, square.color);
+            FillRect(x0, y1 - 1, x1, y1, square.color);
+            FillRect(x0, y0, x0 + 1, y1, square.color);
+            FillRect(x1 - 1, y0, x1, y1, square.color);
+            return;
+        }
+        if (square.s == 0.0f) {
+            FillRect(Snap(square.x), Snap(square.y), Snap(square.x + square.length), Snap(square.y + square.length),
+                     square.color);
+            return;
+        }
+        // Rotated: test each pixel of the bounding box in the square's own frame.
+        float half = square.length * scale / 2.0f;
+        float cx = square.x * scale + half;
+        float cy = square.y * scale + half;
+        float reach = half * 1.4143f; // Half the diagonal.
+        int x0 = static_cast<int>(floorf(cx - reach));
+        int x1 = static_cast<int>(floorf(cx + reach)) + 1;
+        int y0 = static_cast<int>(floorf(cy - reach));
+        int y1 = static_cast<int>(floorf(cy + reach)) + 1;
+        for (int y = y0 < 0 ? 0 : y0; y < (y1 > height ? height : y1); ++y) {
+            float dy = y + 0.5f - cy;
+            for (int x = x0 < 0 ? 0 : x0; x < (x1 > width ? width : x1); ++x) {
+                float dx = x + 0.5f - cx;
+                float u = square.c * dx + square.s * dy;
+                float v = -square.s * dx + square.c * dy;
+                if (u >= -half && u <= half && v >= -half && v <= half) {
+                    pixels[y * width + x] = square.color;
+                }
+            }
+        }
+    }
+
+    void Number(int value, float left, float top, uint8_t color) {
+        char digits[16];
+        int count = snprintf(digits, sizeof(digits), "%d", value < 0 ? 0 : value);
+        int size = Snap(kDigitPixelSize) > 0 ? Snap(kDigitPixelSize) : 1;
+        int x = Snap(left);
+        int y = Snap(top);
+        for (int i = 0; i < count; ++i) {
+            const uint8_t* rows = kDigitRows[digits[i] - '0'];
+            for (int row = 0; row < 5; ++row) {
+                for (int column = 0; column < 3; ++column) {
+                    if (rows[row] & (4 >> column)) {
+                        FillRect(x + column * size, y + row * size, x + (column + 1) * size, y + (row + 1) * size,
+                                 color);
+                    }
+                }
+            }
+            x += 4 * size; // Three columns plus one of spacing.
+        }
+    }
+};
+
+// Draw 'frame' into 'canvas' in the game's order: player, axes, other obstacles, then the score.
+static void Draw(const FrameSnapshot& frame, Canvas& canvas) {
+    memset(canvas.pixels, CAPTURE_BACKGROUND, static_cast<size_t>(canvas.width) * canvas.height);
+    canvas.Circle(frame.playerX, frame.playerY, frame.playerRadius, CAPTURE_PLAYER);
+    for (const CaptureSquare& square : frame.squares) {
+        canvas.Square(square);
+    }
+    canvas.Number(frame.score, 10.0f, 10.0f, CAPTURE_OUTLINE);
+}
+
+// How long frame 'frame' stays up at 'fps' frames per second, in the centiseconds GIF counts in.
+// Rounding each frame's start instead of its length keeps the GIF in step with the game over time.
+static int FrameDelay(long long frame, int fps) {
+    return static_cast<int>((frame + 1) * 100 / fps - frame * 100 / fps);
+}
+
+int main(int argc, char** argv) {
+    int threadCount = 0;
+    int fps = 30;
+    float scale = 1.0f;
+    const char* configPath = nullptr;
+    std::vector<const char*> paths;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threadCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            fps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--scale") == 0 && i + 1 < argc) {
+            scale = static_cast<float>(atof(argv[++i]));
+        } else if (strcmp(argv[i], "--config") == 0 && i + 1 < argc) {
+            configPath = argv[++i];
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (paths.size() != 2 || fps < 1 || fps > 50 || !(scale > 0.0f && scale <= 4.0f)) {
+        printf("usage: axe_capture [-j threads] [--fps 1-50] [--scale 0-4] [--config FILE] REPLAY OUT.gif\n");
+        return 1;
+    }
+    const char* replayPath = paths[0];
+    const char* outputPath = paths[1];
+
+    GameConfig config;
+    std::string configError;
+    if (configPath && !LoadGameConfig(configPath, config, configError)) {
+        printf("%s: %s\n", configPath, configError.c_str());
+        return 1;
+    }
+    // Load() refuses axe counts outside 1..kMaxReplayAxes, so the world below never reserves more
+    // than that however the file was forged.
+    Replay replay;
+    if (!replay.Load(replayPath)) {
+        printf("%s: cannot read replay\n", replayPath);
+        return 1;
+    }
+    if (replay.configHash != SimulationConfigHash(config) || replay.tickRate != kTickRate) {
+        printf("%s: recorded under different rules; the capture will not match the game\n", replayPath);
+    }
+    FILE* output = fopen(outputPath, "wb");
+    if (!output) {
+        printf("%s: cannot write\n", outputPath);
+        return 1;
+    }
+
+    int width = static_cast<int>(config.screenWidth * scale + 0.5f);
+    int height = static_cast<int>(config.screenHeight * scale + 0.5f);
+    width = width > 0 ? width : 1;
+    height = height > 0 ? height : 1;
+    ThreadPool pool(threadCount);
+    std::vector<CaptureWorker> workers(pool.Size());
+    for (CaptureWorker& worker : workers) {
+        worker.canvas.resize(static_cast<size_t>(width) * height);
+    }
+    std::vector<FrameSnapshot> batch(static_cast<size_t>(pool.Size()) * kFramesPerThread);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint8_t> bytes;
+    WriteGifHeader(bytes, width, height, kCapturePalette, CAPTURE_COLOR_COUNT);
+    size_t written = fwrite(bytes.data(), 1, bytes.size(), output);
+    bool ok = written == bytes.size();
+
+    // The simulation runs here, in order; only drawing and compressing are spread over the pool.
+    World world;
+    world.config = config;
+    world.Reset(replay.axeCount, replay.seed);
+    size_t tick = 0;
+    long long frames = 0;
+    bool over = false;
+    while (!over && ok) {
+        size_t used = 0;
+        for (; used < batch.size() && !over; ++used) {
+            // Frame n shows the world at game time n / fps.
+            size_t target = static_cast<size_t>(frames * kTickRate / fps);
+            while (tick < target && !over) {
+                if (tick >= replay.inputs.size()) {
+                    over = true; // The recording ended without a collision.
+                    break;
+                }
+                over = world.Step(kTickSeconds, replay.inputs[tick++]);
+            }
+            FrameSnapshot& frame = batch[used];
+            Snapshot(world, frame);
+            frame.delayCentiseconds = FrameDelay(frames, fps) + (over ? kFinalHoldCentiseconds : 0);
+            ++frames;
+        }
+
+        pool.ParallelFor(static_cast<long long>(used), 1, [&](long long begin, long long end, int worker) {
+            Canvas canvas = {workers[worker].canvas.data(), width, height, scale};
+            for (long long i = begin; i < end; ++i) {
+                FrameSnapshot& frame = batch[i];
+                Draw(frame, canvas);
+                frame.encoded.clear();
+                EncodeGifFrame(canvas.pixels, width, height, CAPTURE_COLOR_COUNT, frame.delayCentiseconds,
+                               frame.encoded);
+            }
+        });
+        for (size_t i = 0; i < used && ok; ++i) {
+            ok = fwrite(batch[i].encoded.data(), 1, batch[i].encoded.size(), output) == batch[i].encoded.size();
+            written += batch[i].encoded.size();
+        }
+    }
+    bytes.clear();
+    WriteGifTrailer(bytes);
+    ok = ok && fwrite(bytes.data(), 1, bytes.size(), output) == bytes.size();
+    written += bytes.size();
+    ok = fclose(output) == 0 && ok;
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!ok) {
+        printf("%s: write failed\n", outputPath);
+        return 1;
+    }
+
+    double gameSeconds = static_cast<double>(tick) / kTickRate;
+    printf("%s: frames=%lld ticks=%zu score=%d bytes=%zu threads=%d seconds=%.3f realtime_x=%.1f\n", outputPath,
+           frames, tick, world.score, written, pool.Size(), seconds, seconds > 0.0 ? gameSeconds / seconds : 0.0);
+    return 0;
+}
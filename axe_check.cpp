@@ -0,0 +1,229 @@
+// Equivalence and round-trip checks for the hand-written fast paths.
+// Every batch kernel must move and bounce axes exactly like the scalar kernel, bit for bit, or
+// replays recorded on one CPU would not verify on another. The replay and upload codecs must give
+// back exactly what they were given, and reject damaged or forged input instead of misreading it.
+// Prints one line per failed check and a summary.
+//
+// Usage: axe_check
+// Exit code: 0 if every check passed, 1 otherwise.
+
+#include "axe_kernels.h" // Kernels under test.
+#include "axe_pool.h"    // The pool the kernels run over.
+#include "leaderboard.h" // Upload batch compression.
+#include "replay.h"      // Replay encoding.
+#include "simulation.h"  // Axe::Move, the rules every kernel implements.
+
+#include <cstdio>  // Failure lines and the summary.
+#include <cstring> // memcmp for bitwise comparisons.
+#include <vector>  // Test data.
+
+static int gChecks = 0;
+static int gFailures = 0;
+
+static void Check(bool passed, const char* what) {
+    ++gChecks;
+    if (!passed) {
+        ++gFailures;
+        printf("FAIL %s\n", what);
+    }
+}
+
+static bool SameBits(const std::vector<float>& a, const std::vector<float>& b) {
+    return a.size() == b.size() && memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+// A pool with axes everywhere a bounce can happen: inside the playfield, on and past every edge,
+// with slow, fast and zero speeds, and a few freed slots in between.
+static void FillPool(AxePool& pool, const GameConfig& config) {
+    const int kAxes = 1001; // Deliberately not a multiple of kAxeLaneWidth.
+    pool.Reserve(kAxes);
+    pool.Clear();
+    Rng rng(2024u);
+    const float speeds[] = {0.0f, 1.0f, config.axeStartSpeedX, config.maxAxeSpeedY, 50000.0f};
+    for (int i = 0; i < kAxes; ++i) {
+        float length = 1.0f + rng.NextFloat() * 2.0f * config.axeLength;
+        float x = (rng.NextFloat() * 1.4f - 0.2f) * config.screenWidth;
+        float y = (rng.NextFloat() * 1.4f - 0.2f) * config.screenHeight;
+        if (i % 7 == 0) {
+            x = (i % 2) ? 0.0f : config.screenWidth - length; // Exactly on an edge.
+        }
+        float vx = speeds[rng.Next() % 5] * ((rng.Next() & 1) ? 1.0f : -1.0f);
+        float vy = speeds[rng.Next() % 5] * ((rng.Next() & 1) ? 1.0f : -1.0f);
+        pool.Spawn(x, y, vx, vy, length);
+    }
+    for (int slot = 3; slot < kAxes; slot += 97) {
+        pool.Despawn(slot);
+    }
+}
+
+static void CheckKernels(const GameConfig& config) {
+    const int kSteps = 600;
+    float width = static_cast<float>(config.screenWidth);
+    float height = static_cast<float>(config.screenHeight);
+    AxePool reference;
+    FillPool(reference, config);
+    const AxeKernel* scalar = FindAxeKernel("scalar");
+    Check(scalar != nullptr, "kernels: the scalar kernel is always available");
+    if (!scalar) {
+        return;
+    }
+
+    // The scalar kernel against the rules it implements, Axe::Move, one live axe at a time.
+    AxePool pool = reference;
+    int lanes = (pool.highWater + kAxeLaneWidth - 1) / kAxeLaneWidth * kAxeLaneWidth;
+    AxeArrays arrays = {pool.x.data(),      pool.y.data(),     pool.vx.data(),    pool.vy.data(),
+                        pool.length.data(), pool.prevX.data(), pool.prevY.data(), lanes};
+    std::vector<Axe> structs;
+    for (int slot = 0; slot < pool.highWater; ++slot) {
+        structs.push_back(pool.Get(slot));
+    }
+    bool matches = true;
+    for (int step = 0; step < kSteps && matches; ++step) {
+        scalar->move(arrays, width, height, kTickSeconds);
+        for (int slot = 0; slot < pool.highWater && matches; ++slot) {
+            if (!pool.alive[slot]) {
+                continue;
+            }
+            Axe& axe = structs[slot];
+            axe.Move(config.screenWidth, config.screenHeight, kTickSeconds);
+            Axe moved = pool.Get(slot);
+            matches = memcmp(&axe.x, &moved.x, sizeof(float)) == 0 && memcmp(&axe.y, &moved.y, sizeof(float)) == 0 &&
+                      memcmp(&axe.speedX, &moved.speedX, sizeof(float)) == 0 &&
+                      memcmp(&axe.speedY, &moved.speedY, sizeof(float)) == 0;
+        }
+    }
+    Check(matches, "kernels: scalar matches Axe::Move bit for bit");
+
+    // Every other kernel this CPU can run against the scalar one, array by array, step by step.
+    const char* names[] = {"sse2", "avx2", "neon"};
+    for (const char* name : names) {
+        const AxeKernel* kernel = FindAxeKernel(name);
+        if (!kernel) {
+            continue;
+        }
+        AxePool expected = reference;
+        AxePool actual = reference;
+        AxeArrays expectedArrays = {expected.x.data(),      expected.y.data(),     expected.vx.data(),
+                                    expected.vy.data(),     expected.length.data(), expected.prevX.data(),
+                                    expected.prevY.data(), lanes};
+        AxeArrays actualArrays = {actual.x.data(),      actual.y.data(),     actual.vx.data(),    actual.vy.data(),
+                                  actual.length.data(), actual.prevX.data(), actual.prevY.data(), lanes};
+        bool sameBounces = true;
+        bool sameState = true;
+        for (int step = 0; step < kSteps && sameBounces && sameState; ++step) {
+            int expectedBounces = scalar->move(expectedArrays, width, height, kTickSeconds);
+            int actualBounces = kernel->move(actualArrays, width, height, kTickSeconds);
+            sameBounces = expectedBounces == actualBounces;
+            sameState = SameBits(expected.x, actual.x) && SameBits(expected.y, actual.y) &&
+                        SameBits(expected.vx, actual.vx) && SameBits(expected.vy, actual.vy) &&
+                        SameBits(expected.prevX, actual.prevX) && SameBits(expected.prevY, actual.prevY);
+        }
+        char what[96];
+        snprintf(what, sizeof(what), "kernels: %s matches scalar bit for bit", name);
+        Check(sameState, what);
+        snprintf(what, sizeof(what), "kernels: %s counts the same bounces as scalar", name);
+        Check(sameBounces, what);
+    }
+}
+
+static bool SameReplay(const Replay& a, const Replay& b) {
+    return a.seed == b.seed && a.configHash == b.configHash && a.tickRate == b.tickRate && a.axeCount == b.axeCount &&
+           a.claimedScore == b.claimedScore && a.inputs == b.inputs;
+}
+
+static void CheckReplays(const GameConfig& config) {
+    // Short runs, runs just around the one- and two-byte LEB128 limits, and one very long hold.
+    Replay recorded;
+    recorded.Begin(37, 0xC0FFEEu, SimulationConfigHash(config));
+    Rng rng(7u);
+    const int runs[] = {1, 2, 127, 128, 129, 16383, 16384, 100000};
+    for (int i = 0; i < 200; ++i) {
+        int run = i % 10 < 8 ? runs[i % 8] : 1 + static_cast<int>(rng.Next() % 50);
+        InputMask input = static_cast<InputMask>(rng.Next() & 0x0F);
+        for (int tick = 0; tick < run; ++tick) {
+            recorded.Record(input);
+        }
+    }
+    recorded.claimedScore = -12345; // Stored as u32; must come back signed.
+    std::vector<uint8_t> bytes = recorded.Encode();
+    Replay decoded;
+    Check(decoded.Decode(bytes.data(), bytes.size()) && SameReplay(recorded, decoded), "replay: round trip");
+
+    Replay empty;
+    empty.Begin(1, 1u, 0u);
+    std::vector<uint8_t> emptyBytes = empty.Encode();
+    Check(decoded.Decode(emptyBytes.data(), emptyBytes.size()) && SameReplay(empty, decoded),
+          "replay: empty round trip");
+
+    // Damaged and forged files are refused, never misread.
+    bool refused = true;
+    for (size_t size = 0; size < bytes.size(); size += 1 + size / 4) {
+        refused = refused && !decoded.Decode(bytes.data(), size);
+    }
+    Check(refused, "replay: truncated files are refused");
+    std::vector<uint8_t> corrupt = bytes;
+    corrupt[40] ^= 0x01;
+    Check(!decoded.Decode(corrupt.data(), corrupt.size()), "replay: a corrupted payload is refused");
+    Check(!decoded.Decode(bytes.data(), bytes.size(), static_cast<uint32_t>(recorded.inputs.size() - 1)),
+          "replay: replays longer than maxTicks are refused");
+    Check(!decoded.Decode(bytes.data(), bytes.size(), kMaxReplayTicks, 36),
+          "replay: replays with more than maxAxes axes are refused");
+    const uint32_t forgedAxes[] = {0u, static_cast<uint32_t>(kMaxReplayAxes) + 1u, 2000000000u, 0xFFFFFFFFu};
+    refused = true;
+    for (uint32_t axes : forgedAxes) {
+        Replay forged = empty;
+        forged.axeCount = static_cast<int>(axes);
+        std::vector<uint8_t> forgedBytes = forged.Encode();
+        refused = refused && !decoded.Decode(forgedBytes.data(), forgedBytes.size());
+    }
+    Check(refused, "replay: forged axe counts are refused");
+}
+
+static void CheckCompression() {
+    // Empty, tiny, incompressible, highly repetitive, and a realistic batch of encoded replays.
+    std::vector<std::vector<uint8_t>> inputs(5);
+    inputs[1] = {42};
+    Rng rng(99u);
+    for (int i = 0; i < 5000; ++i) {
+        inputs[2].push_back(static_cast<uint8_t>(rng.Next()));
+    }
+    for (int i = 0; i < 200000; ++i) {
+        inputs[3].push_back(static_cast<uint8_t>("axe"[i % 3] + (i / 1000) % 2));
+    }
+    for (int i = 0; i < 20; ++i) {
+        Replay replay;
+        replay.Begin(1 + i, static_cast<uint32_t>(i), 1234u);
+        for (int tick = 0; tick < 2000; ++tick) {
+            replay.Record(static_cast<InputMask>((tick / (10 + i)) & 0x0F));
+        }
+        std::vector<uint8_t> bytes = replay.Encode();
+        inputs[4].insert(inputs[4].end(), bytes.begin(), bytes.end());
+    }
+
+    bool roundTrips = true;
+    bool refused = true;
+    for (const std::vector<uint8_t>& input : inputs) {
+        std::vector<uint8_t> compressed = LeaderboardCompress(input.data(), input.size());
+        std::vector<uint8_t> output;
+        roundTrips = roundTrips && LeaderboardDecompress(compressed.data(), compressed.size(), input.size(), output) &&
+                     output == input;
+        // A wrong size claim, a forged huge one, and a cut-off stream.
+        refused = refused && !LeaderboardDecompress(compressed.data(), compressed.size(), input.size() + 1, output);
+        refused = refused && !LeaderboardDecompress(compressed.data(), compressed.size(), kMaxLeaderboardBatchBytes + 1,
+                                                    output);
+        if (!compressed.empty()) {
+            refused = refused && !LeaderboardDecompress(compressed.data(), compressed.size() - 1, input.size(), output);
+        }
+    }
+    Check(roundTrips, "compression: round trip");
+    Check(refused, "compression: wrong sizes and truncated streams are refused");
+}
+
+int main() {
+    GameConfig config;
+    CheckKernels(config);
+    CheckReplays(config);
+    CheckCompression();
+    printf("checks=%d failed=%d kernel=%s\n", gChecks, gFailures, SelectAxeKernel().name);
+    return gFailures == 0 ? 0 : 1;
+}
@@ -1,257 +1,920 @@
 #include "raylib.h" // Include the Raylib library for game development functionalities
 
-// Player structure to encapsulate the player's properties and behaviors.
-// Using a struct helps organize related data and functions, improving code readability and maintainability.
-struct Player {
-    int x;       // X position of the circle's center on the screen
-    int y;       // Y position of the circle's center on the screen
-    int radius;  // Radius of the circular player
-    Color color; // Color of the player
-
-    // Draw the player on the screen. This method knows how to render itself.
-    void Draw() {
-        DrawCircle(x, y, radius, color);
-    }
-
-    // Move the player based on keyboard input, respecting screen boundaries.
-    // 'speed' is defined in pixels per second.
-    void Move(int screenWidth, int screenHeight, float speed) {
-        float deltaTime = GetFrameTime(); // Get the time elapsed since the last frame in seconds.
-                                          // This is crucial for frame-rate independent movement.
-                                          // Movement is calculated based on time, not frames,
-                                          // ensuring consistent speed regardless of FPS fluctuations.
-        // Calculate movement in pixels per frame based on speed and deltaTime.
-        // The result is cast to int because pixel positions are typically integer values.
-        int movementAmount = static_cast<int>(speed * deltaTime); 
-
-        // Update position based on input with boundary checks.
-        // The player's center (x, y) must always be within the screen bounds,
-        // considering its radius to prevent drawing outside the window.
-        if ((IsKeyDown(KEY_D) || IsKeyDown(KEY_RIGHT)) && x < screenWidth - radius) {
-            x += movementAmount;
-        }
-        if ((IsKeyDown(KEY_A) || IsKeyDown(KEY_LEFT)) && x > radius) {
-            x -= movementAmount;
-        }
-        if ((IsKeyDown(KEY_W) || IsKeyDown(KEY_UP)) && y > radius) {
-            y -= movementAmount;
-        }
-        if ((IsKeyDown(KEY_S) || IsKeyDown(KEY_DOWN)) && y < screenHeight - radius) {
-            y += movementAmount;
-        }
-    }
-};
+#include "alloc_counter.h" // Debug check that steady-state frames never allocate.
+#include "assets.h"        // Streamed fonts and textures.
+#include "audio_mixer.h"   // Sound effects, mixed on the audio thread.
+#include "axe_renderer.h"  // Batched drawing of all axes.
+#include "controller.h"    // Pluggable input: the bot plays through it.
+#include "dodge_bot.h"     // Reference bot for unattended runs.
+#include "fixed_pool.h"    // Score popup storage.
+#include "frame_arena.h"   // Per-frame scratch memory for HUD text.
+#include "hud.h"           // Cached HUD and menu text, profiler overlay.
+#include "game_config.h"   // Tuning file loading and hot reload.
+#include "input.h"         // Timestamped input events and just-in-time sampling.
+#include "leaderboard.h"   // Background leaderboard uploads.
+#include "profiler.h"      // Per-phase frame timings.
+#include "replay.h"        // Input recording and playback.
+#include "score_store.h"   // Persistent high scores.
+#include "simulation.h"    // Headless game rules: Player, Axe, World and the input bitmask.
+#include "state_machine.h" // Menu, game, pause and game over screens.
+#include "telemetry.h"     // Gameplay analytics.
+#include "versus_net.h"    // Two-player online versus mode.
 
-// Axe structure to encapsulate the obstacle's properties and behaviors.
-// Similar to Player, using a struct for Axe promotes modularity and encapsulates
-// all axe-related data and functions within a single, coherent unit.
-struct Axe {
-    int x;       // X position of the top-left corner of the square axe
-    int y;       // Y position of the top-left corner of the square axe
-    int length;  // Side length of the square axe
-    float speedX; // Horizontal movement speed of the axe (pixels per second).
-                  // Using float for speed allows for more precise, fractional speed values.
-    float speedY; // Vertical movement speed of the axe (pixels per second).
-    Color color; // Color of the axe
-
-    // Draw the axe on the screen.
-    void Draw() {
-        DrawRectangle(x, y, length, length, color);
-    }
-
-    // Move the axe in both horizontal and vertical directions, bouncing off all screen edges.
-    // The movement is time-based using deltaTime to ensure smooth and consistent motion
-    // regardless of the game's frame rate.
-    void Move(int screenWidth, int screenHeight) {
-        float deltaTime = GetFrameTime(); // Crucial for frame-rate independent movement.
-        x += static_cast<int>(speedX * deltaTime); // Update X position based on horizontal speed.
-        y += static_cast<int>(speedY * deltaTime); // Update Y position based on vertical speed.
-
-        // Reverse horizontal direction if axe hits left or right edge.
-        // The axe's x-coordinate refers to its top-left corner.
-        // So, for the right edge, we check x + length.
-        if (x + length > screenWidth || x < 0) {
-            speedX = -speedX; // Invert horizontal speed to bounce.
-        }
-        // Reverse vertical direction if axe hits top or bottom edge.
-        // Similar logic applies for the bottom edge: y + length.
-        if (y + length > screenHeight || y < 0) {
-            speedY = -speedY; // Invert vertical speed to bounce.
-        }
-    }
+#include <cassert> // Steady-state allocation check.
+#include <chrono>  // Launch-to-first-frame time.
+#include <cmath>   // floorf for pixel snapping.
+#include <cstdio>  // printf for headless replay results.
+#include <cstdlib> // atoi/atof for command-line options.
+#include <cstring> // strcmp for command-line options.
+#include <ctime>   // Versus seeds.
+#include <string>  // Config error messages.
+
+#if defined(PLATFORM_WEB)
+#include <emscripten/emscripten.h> // emscripten_set_main_loop.
+#endif
+
+// Colors are purely presentational, so they live with the rendering code rather than in the simulation.
+const Color kPlayerColor = PURPLE;
+const Color kAxeColor = RED;
+const Color kSpinningAxeColor = MAROON;
+const Color kHomingAxeColor = ORANGE;
+const Color kOpponentColor = DARKBLUE;
+
+// Round a sub-pixel simulation position to the nearest whole pixel for drawing.
+// This is the only place positions become integers; the simulation always keeps the fractions.
+int SnapToPixel(float position) {
+    return static_cast<int>(floorf(position + 0.5f));
+}
+
+// Blend between the position before and after the last simulation tick and snap it to a pixel.
+// 'alpha' is how far the current frame is into the next tick (see FixedStepClock::Alpha).
+int Interpolate(float previous, float current, float alpha) {
+    return SnapToPixel(previous + (current - previous) * alpha);
+}
+
+// Draw the player on the screen, interpolated 'alpha' of a tick past its previous position.
+void DrawPlayer(const Player& player, float alpha) {
+    DrawCircle(Interpolate(player.prevX, player.x, alpha), Interpolate(player.prevY, player.y, alpha),
+               player.radius, kPlayerColor);
+}
+
+// A "+1" that floats up from where the player was whenever the score goes up.
+struct ScorePopup {
+    float x;    // Player center when the points were scored.
+    float y;
+    float age;  // Seconds since the popup appeared.
+    int points; // Points gained.
 };
+const float kPopupSeconds = 0.8f; // How long a popup stays on screen.
+const float kPopupRise = 40.0f;   // How far it floats up over that time, in pixels.
+typedef FixedPool<ScorePopup, 16> ScorePopupPool;
 
-// Function to check collision between the player (circle) and the axe (rectangle).
-// This function acts as a wrapper for Raylib's optimized collision detection.
-// It takes the Player and Axe structs directly, making the call site cleaner.
-bool CheckCollision(Player player, Axe axe) {
-    // Convert the axe's properties into a Raylib Rectangle type.
-    // Raylib's collision functions often require its specific data structures.
-    Rectangle axeRect = {static_cast<float>(axe.x), static_cast<float>(axe.y),
-                         static_cast<float>(axe.length), static_cast<float>(axe.length)};
-    
-    // Use Raylib's optimized function for circle-rectangle collision detection.
-    // Vector2 is used for the circle's center.
-    return CheckCollisionCircleRec(Vector2{static_cast<float>(player.x), static_cast<float>(player.y)},
-                                   static_cast<float>(player.radius), axeRect);
+// Age every popup by 'deltaTime' seconds, retire the expired ones and draw the rest fading out.
+// The text is formatted into the frame arena, so drawing popups never touches the heap.
+void UpdateAndDrawPopups(ScorePopupPool& popups, FrameArena& arena, float deltaTime) {
+    popups.ForEach([&](ScorePopup& popup, int slot) {
+        popup.age += deltaTime;
+        if (popup.age >= kPopupSeconds) {
+            popups.Despawn(slot);
+            return;
+        }
+        float t = popup.age / kPopupSeconds;
+        DrawText(arena.Format("+%i", popup.points), SnapToPixel(popup.x) - 8, SnapToPixel(popup.y - kPopupRise * t),
+                 20, Fade(DARKGREEN, 1.0f - t));
+    });
 }
 
+// Running totals for unattended bot runs (--bot), printed once a minute so an hours-long soak run
+// shows frame times creeping up or frames that hitch, without anyone watching the window.
+struct SoakReport {
+    double nextReport = 0.0; // GetTime() of the next line.
+    int games = 0;           // Totals since the last line.
+    long long score = 0;
+    int frames = 0;
+    double frameSeconds = 0.0;
+    float worstFrame = 0.0f;
+};
+const double kSoakReportSeconds = 60.0;
+const double kBotRestartSeconds = 1.0; // How long the bot looks at the game over screen.
+
 // Enum to manage different distinct states of the game.
 // Using an enum for game states is a common and effective way to structure game logic,
 // making the code more readable, maintainable, and less prone to errors
 // compared to using magic numbers or boolean flags for state.
+// Each state is a row of hooks in kStateHooks below, run by the Game's state machine.
 enum GameState {
     MENU,       // Initial game state: displays a start screen.
     PLAYING,    // Active gameplay state: player and axe move, collision is checked, score updates.
-    GAME_OVER   // State after a collision occurs: displays game over message and restart option.
+    GAME_OVER,  // State after a collision occurs: displays game over message and restart option.
+    PAUSED,     // Overlay on PLAYING: the game is frozen and drawn dimmed underneath.
+    VERSUS,     // Online two-player game (--host or --join), from connecting to the result.
+    GAME_STATE_COUNT
 };
 
-int main() {
-    // Window configuration constants. Using 'const' ensures these values cannot be accidentally changed,
-    // improving code robustness and readability.
-    const int screenWidth = 800;
-    const int screenHeight = 450;
-    const char* windowTitle = "Dan's Axe Game";
+// Re-simulate a replay file without opening a window and print the outcome.
+// Returns a process exit code: 0 if the replay reproduces its claimed score, 1 otherwise.
+int RunHeadlessReplay(const char* path, const GameConfig& config) {
+    // Load() rejects axe counts outside 1..kMaxReplayAxes, so a hostile file cannot make the
+    // simulation below allocate without bound.
+    Replay replay;
+    if (!replay.Load(path)) {
+        printf("%s: cannot read replay\n", path);
+        return 1;
+    }
+    World world;
+    world.config = config;
+    ReplayResult result = SimulateReplay(replay, world);
+    bool valid = result.verified;
+    printf("%s: ticks=%d score=%d claimed=%d config=%s -> %s\n", path, result.ticks, result.score,
+           replay.claimedScore, result.configMatches ? "match" : "mismatch", valid ? "OK" : "MISMATCH");
+    return valid ? 0 : 1;
+}
 
-    // Initialize the game window with specified dimensions and title.
-    InitWindow(screenWidth, screenHeight, windowTitle); 
-    // Set the target frames per second (FPS) to 60. This helps ensure consistent game speed
-    // and smooth animation, especially when combined with deltaTime-based movement.
-    SetTargetFPS(60); 
-
-    // Initialize game entities with their starting properties.
-    Player player = {screenWidth / 2, screenHeight / 2, 25, PURPLE}; 
-    // Axe starts with initial horizontal speed (speedX) and vertical speed (speedY),
-    // creating an immediate diagonal movement.
-    Axe axe = {300, 0, 50, 150.0f, 200.0f, RED}; 
-
-    // Set the initial game state to MENU.
-    GameState currentState = MENU; 
-
-    // Variables for scoring system.
-    int score = 0;         // Current score based on survival time (1 point per second).
-    int highScore = 0;     // Highest score achieved in any game session so far (in-memory).
-    float scoreTimer = 0.0f; // Timer to accumulate time for scoring (in seconds).
-    // Tracks the score at which the axe's speed was last increased.
-    // This prevents the speed from increasing multiple times for the same score point
-    // if the game loop runs very fast.
-    int lastSpeedIncreaseScore = 0; 
-
-    // Variable to track if a collision was detected (primarily for debug visualization).
-    bool collisionDetected = false;
+// Everything the game keeps from one frame to the next. main() sets it up, then the platform drives
+// UpdateDrawFrame(): a plain loop on the desktop, and the browser's requestAnimationFrame on the web,
+// where a blocking loop would freeze the page. Nothing in a frame may wait for the next one.
+struct Game {
+    // Command-line options; see the usage comment above main().
+    int axeCount = 1;
+    const char* recordPath = nullptr;
+    float replaySpeed = 1.0f;
+    const char* configPath = "axe_game.cfg";
+    int versusPort = 0;                  // --host PORT
+    const char* versusAddress = nullptr; // --join HOST:PORT
+    const char* telemetryTarget = nullptr; // --telemetry FILE or tcp:HOST:PORT
+    bool botPlaying = false;             // --bot
+    bool muted = false;                  // --mute
 
-    // Main game loop. Continues as long as the window is not closed.
-    // This loop handles game state updates, input processing, and rendering for each frame.
-    while (!WindowShouldClose()) { 
-        BeginDrawing(); // Start the drawing phase. All drawing commands between BeginDrawing()
-                        // and EndDrawing() are buffered and then drawn to the screen.
-        ClearBackground(WHITE); // Clear the screen with a white color for a fresh frame.
-                                // This prevents "smearing" or drawing artifacts from previous frames.
-
-        // Game logic and rendering based on the current game state.
-        // The switch statement elegantly manages transitions and behaviors for different game phases.
-        switch (currentState) {
-            case MENU:
-                // Display instructions for starting the game.
-                // MeasureText is used to center the text dynamically.
-                DrawText("Press SPACE to Start", screenWidth / 2 - MeasureText("Press SPACE to Start", 20) / 2, screenHeight / 2 - 10, 20, BLACK);
-                if (IsKeyPressed(KEY_SPACE)) {
-                    // Reset game state variables for a new game.
-                    // This ensures a fresh start each time the game is played.
-                    player.x = screenWidth / 2;
-                    player.y = screenHeight / 2;
-                    axe.x = 300;
-                    axe.y = 0;
-                    axe.speedX = 150.0f; // Initial horizontal speed.
-                    axe.speedY = 200.0f; // Initial vertical speed.
-                    score = 0; 
-                    scoreTimer = 0.0f; 
-                    lastSpeedIncreaseScore = 0;
-                    currentState = PLAYING; // Transition to the PLAYING state.
-                }
-                break;
+    // Window configuration. The playfield size comes from the config so both always agree.
+    int screenWidth = 0;
+    int screenHeight = 0;
+
+    // All keyboard input goes through the input stage; see input.h.
+    InputStage input;
+    LateSamplePacer pacer;
+    // Holds frames back on the idle screens; see StatePacer.
+    StatePacer statePacer;
+
+    // This frame's input, for the state hooks.
+    FrameKeys keys = {};
+    double sampleTime = 0.0;
+
+    // The world holds the player, the axes and the score; see simulation.h.
+    World world;
+    // Each new game gets a fresh seed so bullet hell layouts differ from round to round.
+    uint32_t gameSeed = 1u;
+    // Converts rendered frame times into fixed simulation ticks.
+    FixedStepClock clock;
+    // Per-phase frame timings: F3 toggles the overlay, F4 writes the history to profile.csv.
+    FrameProfiler profiler;
+
+    // When watching a replay its header decides the axe count and seed.
+    Replay replay;
+    bool replaying = false;
+    size_t replayTick = 0; // Next input to feed from 'replay'.
+
+    // Finished games go to the leaderboard in the background; anything undelivered waits in
+    // leaderboard.spool until the server can be reached again. Replays are never re-submitted.
+    LeaderboardClient leaderboard;
+    bool uploading = false;
+
+    // Gameplay events for analytics (--telemetry); the world reports its own while a game is played.
+    TelemetryStream telemetry;
+
+    // Inputs of the game in progress, saved when it ends if --record was given and uploaded if
+    // the leaderboard is enabled.
+    Replay recording;
+    bool recordingGames = false;
+
+    // Saving the config file applies it between two frames (see game_config.h). A game whose rules
+    // changed while it was running cannot be replayed, so it is not recorded, scored or uploaded.
+    // Replays are watched under the rules they were recorded with, so nothing is watched then.
+    ConfigWatcher configWatcher;
+    bool rulesChanged = false;
+
+    // Long-lived effects come from fixed pools and per-frame text from the frame arena, which is
+    // reset at the start of every frame; neither touches the heap once the game is running.
+    ScorePopupPool popups;
+    FrameArena frameArena;
+
+    // With --bot a DodgeBot plays instead of the keyboard, restarting after every game, forever.
+    // Its games are recorded like any other but never scored or uploaded.
+    DodgeBot bot;
+    Controller autopilot; // Not connected unless --bot.
+    double gameOverTime = 0.0;
+    SoakReport soak;
+
+    // Bounce, hit and speed-up sounds. Ticks only count what happened; each sound is sent to the
+    // mixer at most once per frame, however many axes bounced.
+    AudioMixer audio;
+
+    // Online versus game; see versus_net.h. It has its own simulation, not 'world'.
+    VersusPeer versus;
+
+    // Screens, starting with the menu, or straight into the replay. See state_machine.h.
+    StateMachine<Game> states;
+    bool resumeClock = false;   // The next game frame restarts the clock (after idle or paused frames).
+    float gameFrameTime = 0.0f; // Game time this frame advanced, for effects; 0 unless playing.
+
+    // Best scores survive restarts in scores.dat (see score_store.h). Each axe count has its own.
+    // Replays are never submitted, so watching one cannot change the table.
+    ScoreStore scores;
+
+    // Only what the menu shows is loaded before the first frame; everything else streams in
+    // while the menu is up (see assets.h). The HUD font is optional: until it is ready, or if
+    // the file is missing, text uses raylib's built-in font.
+    AssetManager assets;
+    int hudFont = -1;
+    std::chrono::steady_clock::time_point launchTime; // Set by main() on entry.
+    bool presentedFirstFrame = false;
+
+    // Menu and HUD text. Constant labels are rendered once into textures; the numeric ones are
+    // only re-formatted and re-measured when their value changes. The game over labels are
+    // rendered the first time the game over screen comes up, not at startup.
+    StaticLabel startPrompt;
+    StaticLabel gameOverTitle;
+    StaticLabel restartPrompt;
+    StaticLabel pausedTitle;
+    StaticLabel resumePrompt;
+    CachedNumberText scoreText;
+    CachedNumberText finalScoreText;
+    CachedNumberText highScoreText;
+    CachedNumberText uploadText;
+
+    // Set everything up once the window is open. 'config' is the tuning to start with and
+    // 'leaderboardUrl' the server to upload to, if any.
+    void Init(const GameConfig& config, bool justInTime, const char* leaderboardUrl);
+
+    // Start (or restart) a game: a fresh world, and a fresh recording or replay position.
+    // Run on entering PLAYING, so the menu and the game over screen always reset the same way.
+    void StartGame();
+
+    // Frame pacing for 'state', from the current config.
+    PacingRule PacingFor(int state) const;
+
+    // State hooks; see kStateHooks.
+    void UpdateMenu(float deltaTime);
+    void DrawMenu();
+    void EnterPlaying();
+    void UpdatePlaying(float deltaTime);
+    void DrawPlaying();
+    void EnterGameOver();
+    void UpdateGameOver(float deltaTime);
+    void DrawGameOver();
+    void EnterPaused();
+    void ExitPaused();
+    void UpdatePaused(float deltaTime);
+    void DrawPaused();
+    void EnterVersus();
+    void UpdateVersus(float deltaTime);
+    void DrawVersus();
+
+    // Add this frame to the bot run's totals and print them once a minute.
+    void ReportSoak();
 
-            case PLAYING:
-                // Update game entities' positions.
-                player.Move(screenWidth, screenHeight, 300.0f); // Player speed set to 300 pixels/second.
-                axe.Move(screenWidth, screenHeight); // Axe moves in both directions based on its speeds.
-
-                // Update score based on survival time (1 point per second).
-                scoreTimer += GetFrameTime(); // Accumulate time. GetFrameTime() provides the time
-                                              // elapsed since the last frame, ensuring time-based scoring.
-                if (scoreTimer >= 1.0f) { // Every second, increment score.
-                    score += 1;
-                    scoreTimer -= 1.0f; // Subtract 1.0f to maintain precision for remaining time.
-                                        // This prevents scoreTimer from growing indefinitely and losing precision.
-                }
-
-                // Increase axe speed every 10 points to make the game progressively harder.
-                // This dynamic difficulty scaling keeps the game challenging as the player improves.
-                if (score > lastSpeedIncreaseScore && score % 10 == 0) {
-                    // Increase speed by 10% each time, up to a maximum.
-                    // Capping the speed prevents the "tunneling" effect (where objects move so fast
-                    // they pass through others without collision detection) and keeps the game playable.
-                    if (axe.speedX < 300.0f) { // Maximum horizontal speed.
-                        axe.speedX *= 1.1f; // Increase by 10%.
-                    }
-                    if (axe.speedY < 400.0f) { // Maximum vertical speed.
-                        axe.speedY *= 1.1f; // Increase by 10%.
-                    }
-                    lastSpeedIncreaseScore = score; // Update the last score at which speed was increased.
-                }
-
-                // Check for collision between player and axe.
-                collisionDetected = CheckCollision(player, axe);
-                if (collisionDetected) {
-                    currentState = GAME_OVER; // Transition to GAME_OVER state on collision.
-                }
-
-                // Draw game entities with debug visualization for collision.
-                player.Draw(); // Render the player.
-                axe.Draw();    // Render the axe.
-                if (collisionDetected) {
-                    // Draw outlines around colliding objects for visual debugging.
-                    // This is helpful during development to verify collision logic.
-                    DrawCircleLines(player.x, player.y, player.radius, BLACK);
-                    DrawRectangleLines(axe.x, axe.y, axe.length, axe.length, BLACK);
-                }
-                // Display current score in the top-left corner.
-                // TextFormat is a convenient Raylib function for creating formatted strings.
-                DrawText(TextFormat("Score: %i", score), 10, 10, 20, BLACK);
+    // Run one frame: input, simulation ticks, drawing and presenting. Returns to the caller
+    // without waiting for anything beyond the present itself (and, on the idle screens, the
+    // input or timer that is worth a new frame).
+    void UpdateDrawFrame();
+
+    // Release what belongs to the OpenGL context, before the window closes.
+    void Unload();
+};
+
+// Hooks of every GameState, in enum order.
+static const StateHooks<Game> kStateHooks[GAME_STATE_COUNT] = {
+    /* MENU      */ {nullptr, nullptr, &Game::UpdateMenu, &Game::DrawMenu, false},
+    /* PLAYING   */ {&Game::EnterPlaying, nullptr, &Game::UpdatePlaying, &Game::DrawPlaying, false},
+    /* GAME_OVER */ {&Game::EnterGameOver, nullptr, &Game::UpdateGameOver, &Game::DrawGameOver, false},
+    /* PAUSED    */ {&Game::EnterPaused, &Game::ExitPaused, &Game::UpdatePaused, &Game::DrawPaused, true},
+    /* VERSUS    */ {&Game::EnterVersus, nullptr, &Game::UpdateVersus, &Game::DrawVersus, false},
+};
+
+void Game::Init(const GameConfig& config, bool justInTime, const char* leaderboardUrl) {
+    screenWidth = config.screenWidth;
+    screenHeight = config.screenHeight;
+
+    input.Install();
+    pacer.enabled = justInTime;
+
+    world.config = config;
+    world.Reset(axeCount);
+    world.profiler = &profiler;
+
+#if !defined(PLATFORM_WEB)
+    uploading = leaderboardUrl && !replaying && leaderboard.Start(leaderboardUrl, "leaderboard.spool");
+    if (leaderboardUrl && !uploading && !replaying) {
+        printf("%s: expected HOST:PORT[/PATH], leaderboard disabled\n", leaderboardUrl);
+    }
+    if (!replaying) {
+        configWatcher.Start(configPath);
+    }
+    scores.Open("scores.dat");
+#else
+    // The web build has no threads, sockets or persistent files: the config is preloaded into the
+    // page and not watched, uploads are off, and high scores last for the session (Best() still
+    // works without a file).
+    (void)leaderboardUrl;
+#endif
+    recordingGames = recordPath || uploading;
+    if (botPlaying && !replaying) {
+        autopilot = MakeController("bot", bot);
+        soak.nextReport = GetTime() + kSoakReportSeconds;
+    }
+
+    // Watching a replay is not playing, so it reports nothing.
+    if (telemetryTarget && !replaying) {
+        if (telemetry.Start(telemetryTarget)) {
+            world.telemetry = &telemetry;
+            telemetry.Emit(TELEMETRY_SESSION_START, axeCount);
+        } else {
+            printf("%s: cannot open, telemetry disabled\n", telemetryTarget);
+        }
+    }
+
+    if (!muted && !audio.Start("resources")) {
+        printf("audio: no output device, sounds disabled\n");
+    }
+
+    frameArena.Init(16 * 1024);
+    states.Init(kStateHooks);
+    // A versus game takes the whole session: it starts right away and lasts until the window closes.
+    bool versusGame = versusPort > 0 || versusAddress;
+#if defined(PLATFORM_WEB)
+    if (versusGame) {
+        printf("versus mode: browsers cannot open UDP sockets\n");
+    }
+#else
+    if (versusPort > 0 && !versus.Host(versusPort, world.config, axeCount, static_cast<uint32_t>(time(nullptr)))) {
+        printf("versus mode: cannot open UDP port %i\n", versusPort);
+    } else if (versusPort <= 0 && versusAddress && !versus.Join(versusAddress, world.config)) {
+        printf("versus mode: cannot resolve %s\n", versusAddress);
+    }
+#endif
+    states.Change(versusGame ? VERSUS : (replaying ? PLAYING : MENU));
+    states.ApplyTransitions(*this);
+
+    startPrompt.Load("Press SPACE to Start", 20, BLACK);
+    scoreText.Init("Score: %i", 20);
+    finalScoreText.Init("Your Score: %i", 20);
+    highScoreText.Init("High Score: %i", 20);
+    uploadText.Init("Leaderboard uploads pending: %i", 10);
+
+    hudFont = assets.Add(ASSET_FONT, "resources/hud_font.ttf", 20);
+    assets.StartStreaming();
+}
+
+void Game::StartGame() {
+    uint32_t seed = replaying ? replay.seed : ++gameSeed;
+    world.Reset(axeCount, seed);
+    clock.Reset();
+    replayTick = 0;
+    rulesChanged = false;
+    popups.Clear();
+    if (autopilot.Connected()) {
+        bot.Reserve(world.axes.liveCount + world.config.spinningAxes + world.config.homingAxes);
+        bot.Reset();
+    }
+    if (recordingGames) {
+        recording.Begin(axeCount, seed, SimulationConfigHash(world.config));
+    }
+}
+
+PacingRule Game::PacingFor(int state) const {
+    const GameConfig& config = world.config;
+    double idleSeconds = config.idleRedrawMs / 1000.0;
+    switch (state) {
+        case PLAYING:
+        case VERSUS:
+            return PacingRule{config.playingFps, false, idleSeconds};
+        case MENU:
+        case PAUSED: // A frozen game is as idle as the menu.
+            return PacingRule{config.menuFps, config.menuFps == 0, idleSeconds};
+        default:
+            break;
+    }
+    return PacingRule{config.gameOverFps, config.gameOverFps == 0, idleSeconds};
+}
+
+void Game::UpdateMenu(float) {
+    if (keys.start || autopilot.Connected()) {
+        states.Change(PLAYING);
+    }
+}
+
+void Game::DrawMenu() {
+    // Display instructions for starting the game, centered on the screen.
+    ProfileScope scope(&profiler, PHASE_HUD);
+    startPrompt.DrawCentered(screenWidth / 2, screenHeight / 2 - 10);
+}
+
+void Game::EnterPlaying() {
+    StartGame(); // Fresh player, axes and score for a new game.
+    resumeClock = true;
+}
+
+void Game::UpdatePlaying(float deltaTime) {
+    // Run as many fixed ticks as the elapsed frame time covers. Each tick stands for a moment in
+    // real time: the last one ends where the leftover accumulator begins, and the ones before it
+    // are a tick apart. A tick gets the keys held at that moment (or, in a replay, the recorded
+    // input of that tick). All movement, scoring, difficulty ramp and collision rules live in
+    // World::Step. 'deltaTime' is the length of the previous frame; if that frame was on an idle
+    // or paused screen it includes the wait for the key that led here, so it does not count.
+    float speed = replaying ? replaySpeed : 1.0f;
+    gameFrameTime = resumeClock ? 0.0f : deltaTime * speed;
+    resumeClock = false;
+    int ticks = clock.Advance(gameFrameTime, static_cast<int>(kMaxCatchUpTicks * speed));
+    int scoreBefore = world.score;
+    int bounces = 0;
+    bool spedUp = false;
+    double lastTickEnd = sampleTime - clock.accumulator;
+    for (int tick = 0; tick < ticks; ++tick) {
+        InputMask held = input.HeldAt(lastTickEnd - (ticks - 1 - tick) * kTickSeconds);
+        if (replaying) {
+            if (replayTick >= replay.inputs.size()) {
+                states.Change(GAME_OVER); // The recording ended without a collision.
+                break;
+            }
+            held = replay.inputs[replayTick++];
+        } else if (autopilot.Connected()) {
+            held = autopilot.Next(world);
+        }
+        if (recordingGames) {
+            recording.Record(held);
+        }
+        bool hit = world.Step(kTickSeconds, held);
+        bounces += world.bounces;
+        spedUp = spedUp || world.speedRamped;
+        if (hit) {
+            states.Change(GAME_OVER); // Transition to GAME_OVER state on collision.
+            telemetry.Emit(TELEMETRY_GAME_OVER, world.score);
+            audio.Play(SOUND_HIT);
+            if (replaying || rulesChanged) {
                 break;
+            }
+            if (autopilot.Connected()) {
+                soak.games += 1;
+                soak.score += world.score;
+            } else {
+                scores.Submit(world.score, axeCount); // Queued; the disk write is async.
+            }
+            recording.claimedScore = world.score;
+            if (recordPath) {
+                recording.Save(recordPath);
+            }
+            if (uploading && !autopilot.Connected()) {
+                leaderboard.Submit(recording.Encode()); // Only queued here.
+            }
+            break;
+        }
+    }
 
-            case GAME_OVER:
-                // Update high score if current score is higher.
-                if (score > highScore) {
-                    highScore = score;
-                }
-                // Display game over messages with current and high score.
-                DrawText("Game Over!", screenWidth / 2 - MeasureText("Game Over!", 40) / 2, screenHeight / 2 - 50, 40, RED);
-                DrawText(TextFormat("Your Score: %i", score), screenWidth / 2 - MeasureText(TextFormat("Your Score: %i", score), 20) / 2, screenHeight / 2 - 10, 20, BLACK);
-                DrawText(TextFormat("High Score: %i", highScore), screenWidth / 2 - MeasureText(TextFormat("High Score: %i", highScore), 20) / 2, screenHeight / 2 + 20, 20, BLACK);
-                DrawText("Press R to Restart", screenWidth / 2 - MeasureText("Press R to Restart", 20) / 2, screenHeight / 2 + 50, 20, BLACK);
-                
-                // Reset game state on 'R' key press.
-                if (IsKeyPressed(KEY_R)) {
-                    // Reset player and axe positions to their initial values.
-                    // This prepares the game for a new round.
-                    player.x = screenWidth / 2;
-                    player.y = screenHeight / 2;
-                    axe.x = 300;
-                    axe.y = 0;
-                    axe.speedX = 150.0f; // Reset horizontal speed.
-                    axe.speedY = 200.0f; // Reset vertical speed.
-                    score = 0; // Reset score for new game.
-                    scoreTimer = 0.0f; // Reset timer for scoring.
-                    lastSpeedIncreaseScore = 0; // Reset speed increase tracker.
-                    currentState = PLAYING; // Return to PLAYING state to restart the game.
-                }
+    if (bounces > 0) {
+        audio.Play(SOUND_BOUNCE, bounces);
+    }
+    if (spedUp) {
+        audio.Play(SOUND_SPEED_UP);
+    }
+    if (world.score > scoreBefore) {
+        popups.Spawn(ScorePopup{world.player.x, world.player.y - world.player.radius, 0.0f,
+                                world.score - scoreBefore}); // Dropped if all slots are busy.
+    }
+    if (keys.pause && !states.Pending()) { // Not when the game just ended.
+        states.Push(PAUSED);
+    }
+}
+
+void Game::DrawPlaying() {
+    // Draw game entities with debug visualization for collision.
+    // Once the game is over, draw the exact final positions rather than interpolating.
+    float alpha = world.collided ? 1.0f : clock.Alpha();
+    {
+        ProfileScope scope(&profiler, PHASE_DRAW);
+        DrawPlayer(world.player, alpha); // Render the player.
+        DrawAxesBatched(world.axes, alpha, kAxeColor); // Render all axes in one batch.
+        DrawObstaclesBatched(world.obstacles, alpha, kSpinningAxeColor, kHomingAxeColor);
+        if (world.collided) {
+            // Draw outlines around colliding objects for visual debugging.
+            // This is helpful during development to verify collision logic.
+            DrawCircleLines(SnapToPixel(world.player.x), SnapToPixel(world.player.y), world.player.radius, BLACK);
+            if (world.hitAxe >= 0) {
+                Axe hit = world.axes.Get(world.hitAxe);
+                DrawRectangleLines(SnapToPixel(hit.x), SnapToPixel(hit.y), static_cast<int>(hit.length),
+                                   static_cast<int>(hit.length), BLACK);
+            } else if (const Position* hit = world.obstacles.Get<Position>(world.hitObstacle)) {
+                // Outline the obstacle's unrotated bounds; close enough for a debug aid.
+                int length = static_cast<int>(world.obstacles.Get<Extent>(world.hitObstacle)->length);
+                DrawRectangleLines(SnapToPixel(hit->x), SnapToPixel(hit->y), length, length, BLACK);
+            }
+        }
+    }
+    // Display current score in the top-left corner, and the score popups. Under the pause overlay
+    // no game time passes, so the popups hold still.
+    {
+        ProfileScope scope(&profiler, PHASE_HUD);
+        UpdateAndDrawPopups(popups, frameArena, gameFrameTime);
+        scoreText.Set(world.score);
+        scoreText.Draw(10, 10, BLACK);
+    }
+}
+
+void Game::EnterGameOver() {
+    // Rendered on first use rather than at startup, which keeps the first frame cheap.
+    if (!gameOverTitle.Loaded()) {
+        gameOverTitle.Load("Game Over!", 40, RED);
+        restartPrompt.Load("Press R to Restart", 20, BLACK);
+    }
+    gameOverTime = GetTime();
+}
+
+void Game::UpdateGameOver(float) {
+    // Restart on 'R' (the bot after a moment). Entering PLAYING resets everything, exactly as
+    // starting from the menu does.
+    bool botRestart = autopilot.Connected() && GetTime() - gameOverTime >= kBotRestartSeconds;
+    if (keys.restart || botRestart) {
+        states.Change(PLAYING);
+    }
+}
+
+void Game::DrawGameOver() {
+    // Display game over messages with current and high score.
+    ProfileScope scope(&profiler, PHASE_HUD);
+    finalScoreText.Set(world.score);
+    highScoreText.Set(scores.Best(axeCount));
+    gameOverTitle.DrawCentered(screenWidth / 2, screenHeight / 2 - 50);
+    finalScoreText.DrawCentered(screenWidth / 2, screenHeight / 2 - 10, BLACK);
+    highScoreText.DrawCentered(screenWidth / 2, screenHeight / 2 + 20, BLACK);
+    restartPrompt.DrawCentered(screenWidth / 2, screenHeight / 2 + 50);
+    if (uploading) {
+        uploadText.Set(leaderboard.Pending());
+        uploadText.DrawCentered(screenWidth / 2, screenHeight - 20, leaderboard.Offline() ? GRAY : DARKGREEN);
+    }
+}
+
+void Game::EnterPaused() {
+    if (!pausedTitle.Loaded()) {
+        pausedTitle.Load("Paused", 40, DARKGRAY);
+        resumePrompt.Load("Press P to Resume", 20, BLACK);
+    }
+}
+
+void Game::ExitPaused() {
+    resumeClock = true; // Time spent paused does not count towards the game.
+}
+
+void Game::UpdatePaused(float) {
+    if (keys.pause) {
+        states.Pop();
+    }
+}
+
+void Game::DrawPaused() {
+    ProfileScope scope(&profiler, PHASE_HUD);
+    DrawRectangle(0, 0, screenWidth, screenHeight, Fade(WHITE, 0.6f)); // Dim the frozen game.
+    pausedTitle.DrawCentered(screenWidth / 2, screenHeight / 2 - 30);
+    resumePrompt.DrawCentered(screenWidth / 2, screenHeight / 2 + 20);
+}
+
+// Versus axes and players. The versus state keeps plain Axe values, not an AxePool, so it has its
+// own small draw loop; there are at most kVersusMaxAxes.
+void DrawVersusScene(const VersusState& state, int localSide, float alpha) {
+    for (int i = 0; i < state.axeCount; ++i) {
+        const Axe& axe = state.axes[i];
+        DrawRectangle(Interpolate(axe.prevX, axe.x, alpha), Interpolate(axe.prevY, axe.y, alpha),
+                      static_cast<int>(axe.length), static_cast<int>(axe.length), kAxeColor);
+    }
+    for (int side = 0; side < kVersusPlayers; ++side) {
+        const Player& player = state.players[side];
+        DrawCircle(Interpolate(player.prevX, player.x, alpha), Interpolate(player.prevY, player.y, alpha),
+                   player.radius, side == localSide ? kPlayerColor : kOpponentColor);
+    }
+}
+
+void Game::EnterVersus() {
+    clock.Reset();
+    resumeClock = true;
+}
+
+void Game::UpdateVersus(float deltaTime) {
+    // Same fixed ticks as a single-player game, but each one goes through the rollback session:
+    // the local input applies at once and the opponent's is predicted until it arrives. When this
+    // side is too far ahead the session refuses the tick, and the time is simply not simulated.
+    versus.Receive();
+    float frameTime = resumeClock ? 0.0f : deltaTime;
+    resumeClock = false;
+    int ticks = clock.Advance(frameTime);
+    double lastTickEnd = sampleTime - clock.accumulator;
+    if (versus.status == VERSUS_PLAYING) {
+        ticks -= versus.TicksToYield();
+        for (int tick = 0; tick < ticks; ++tick) {
+            InputMask held = input.HeldAt(lastTickEnd - (ticks - 1 - tick) * kTickSeconds);
+            if (!versus.session.Advance(held)) {
                 break;
+            }
         }
+    } else {
+        input.HeldAt(sampleTime); // No game yet: do not let movement pile up.
+    }
+    versus.Send();
+}
+
+void Game::DrawVersus() {
+    ProfileScope scope(&profiler, PHASE_DRAW);
+    const char* message = nullptr;
+    switch (versus.status) {
+        case VERSUS_OFF:
+            message = "Versus mode could not start";
+            break;
+        case VERSUS_WAITING:
+            message = versus.hosting ? frameArena.Format("Waiting for an opponent on port %i...", versusPort)
+                                     : frameArena.Format("Joining %s...", versusAddress);
+            break;
+        case VERSUS_REJECTED:
+            message = "The host plays with a different axe_game.cfg";
+            break;
+        case VERSUS_TIMED_OUT:
+            message = "Connection lost";
+            break;
+        case VERSUS_DESYNCED:
+            message = "The games went out of sync";
+            break;
+        case VERSUS_PLAYING:
+            break;
+    }
+    if (message) {
+        int width = MeasureText(message, 20);
+        DrawText(message, screenWidth / 2 - width / 2, screenHeight / 2 - 10, 20, BLACK);
+        return;
+    }
+
+    const RollbackSession& session = versus.session;
+    const VersusState& state = session.state;
+    DrawVersusScene(state, session.localSide, state.overTick >= 0 ? 1.0f : clock.Alpha());
+    DrawText(frameArena.Format("Score: %i", state.score), 10, 10, 20, BLACK);
+    if (session.ConfirmedOver()) {
+        bool localHit = state.hit[session.localSide] != 0;
+        bool remoteHit = state.hit[1 - session.localSide] != 0;
+        const char* result = localHit && remoteHit ? "Draw!" : (localHit ? "You lose!" : "You win!");
+        int width = MeasureText(result, 40);
+        DrawText(result, screenWidth / 2 - width / 2, screenHeight / 2 - 40, 40, localHit ? RED : DARKGREEN);
+    }
+}
+
+void Game::UpdateDrawFrame() {
+    // Idle screens wait here for input or their timer; outside the profiled frame, since the wait
+    // is not work.
+    statePacer.Wait(PacingFor(states.Top()));
+
+    profiler.BeginFrame();
+    frameArena.Reset();
+    uint64_t allocationsAtFrameStart = ThreadAllocationCount();
+    gameFrameTime = 0.0f;
+
+    // Gather this frame's input before anything is drawn. In just-in-time mode, first sleep for
+    // as long as the frame can afford and then pump the OS events, so the input is as fresh as
+    // possible when the frame reaches the screen.
+    pacer.WaitForSample();
+    {
+        ProfileScope scope(&profiler, PHASE_INPUT);
+        keys = input.Poll(pacer.enabled);
+    }
+    sampleTime = pacer.sampleTime;
+    if (keys.toggleProfiler) {
+        profiler.enabled = !profiler.enabled;
+    }
+    if (keys.dumpProfile) {
+        profiler.DumpCsv("profile.csv");
+    }
+    if (states.Top() != PLAYING && states.Top() != VERSUS) {
+        input.HeldAt(sampleTime); // Nothing consumes movement outside a game; do not let it pile up.
+    }
+
+    audio.Update(); // Only does anything on the web, which mixes on the main thread.
 
+    // Upload whatever the loader finished since the last frame and switch the HUD over to it.
+    bool assetsChanged = assets.Update();
+    if (assetsChanged) {
+        if (const Font* font = assets.GetFont(hudFont)) {
+            scoreText.SetFont(font);
+            finalScoreText.SetFont(font);
+            highScoreText.SetFont(font);
+        }
+    }
+
+    // Apply a reloaded config before this frame's ticks. The window cannot be resized, so the
+    // playfield keeps the size the game started with.
+    ConfigUpdate update;
+    bool configTaken = configWatcher.TakeUpdate(update);
+    if (configTaken) {
+        if (!update.ok) {
+            printf("%s: %s, keeping the current settings\n", configPath, update.error.c_str());
+        } else {
+            update.config.screenWidth = screenWidth;
+            update.config.screenHeight = screenHeight;
+            world.config = update.config;
+            rulesChanged = rulesChanged || states.Active(PLAYING);
+            printf("%s: reloaded\n", configPath);
+        }
+    }
+
+    BeginDrawing(); // Start the drawing phase. All drawing commands between BeginDrawing()
+                    // and EndDrawing() are buffered and then drawn to the screen.
+    ClearBackground(WHITE); // Clear the screen with a white color for a fresh frame.
+                            // This prevents "smearing" or drawing artifacts from previous frames.
+
+    // Only the top state updates; it and any states under overlays draw. Transitions the hooks
+    // ask for wait until the frame is presented.
+    states.Update(*this, GetFrameTime());
+    states.Draw(*this);
+
+    if (profiler.enabled) {
+        DrawProfilerOverlay(profiler, frameArena, screenWidth - 260, 10);
+    }
+
+    {
+        ProfileScope scope(&profiler, PHASE_PRESENT);
+        pacer.BeginPresent();
         EndDrawing(); // End the drawing phase and display the frame.
+        pacer.EndPresent();
+    }
+    profiler.EndFrame();
+
+    // Between frames, and so between ticks: carry out the transitions this frame asked for.
+    bool transitioned = states.ApplyTransitions(*this);
+
+    if (autopilot.Connected()) {
+        ReportSoak();
+    }
+
+    bool firstFrame = !presentedFirstFrame;
+    if (firstFrame) {
+        presentedFirstFrame = true;
+        std::chrono::duration<double, std::milli> sinceLaunch = std::chrono::steady_clock::now() - launchTime;
+        double millis = sinceLaunch.count();
+        printf("startup: first frame %.1f ms after launch\n", millis);
+    }
+
+    // A frame that stays in one state without reloading, loading or saving anything is steady state
+    // and must not allocate. Only checked in AXE_COUNT_ALLOCS builds; see alloc_counter.h.
+    if (kCountAllocations && !transitioned && !configTaken && !keys.dumpProfile &&
+        !assetsChanged && !firstFrame) {
+        uint64_t allocations = ThreadAllocationCount() - allocationsAtFrameStart;
+        if (allocations != 0) {
+            printf("steady-state frame made %llu heap allocations\n", static_cast<unsigned long long>(allocations));
+        }
+        assert(allocations == 0);
+    }
+}
+
+void Game::ReportSoak() {
+    float frameTime = GetFrameTime();
+    soak.frames += 1;
+    soak.frameSeconds += frameTime;
+    soak.worstFrame = frameTime > soak.worstFrame ? frameTime : soak.worstFrame;
+    double now = GetTime();
+    if (now < soak.nextReport) {
+        return;
+    }
+    printf("soak: %.0f s games=%i mean_score=%.1f frames=%i mean_frame_ms=%.2f worst_frame_ms=%.2f\n", now,
+           soak.games, soak.games ? static_cast<double>(soak.score) / soak.games : 0.0, soak.frames,
+           soak.frames ? soak.frameSeconds * 1000.0 / soak.frames : 0.0, soak.worstFrame * 1000.0);
+    double nextReport = soak.nextReport + kSoakReportSeconds;
+    soak = SoakReport();
+    soak.nextReport = nextReport;
+}
+
+void Game::Unload() {
+    startPrompt.Unload();
+    if (gameOverTitle.Loaded()) {
+        gameOverTitle.Unload();
+        restartPrompt.Unload();
+    }
+    if (pausedTitle.Loaded()) {
+        pausedTitle.Unload();
+        resumePrompt.Unload();
+    }
+    assets.Unload();
+    audio.Stop();
+}
+
+// The one game instance. It lives on the heap for the whole run: in the browser main() returns
+// to the page right after handing the frame callback over, while frames keep coming.
+static Game* gGame = nullptr;
+
+// Frame callback with the plain function signature emscripten_set_main_loop expects.
+static void UpdateDrawFrame() {
+    gGame->UpdateDrawFrame();
+}
+
+// Usage: game [--config FILE] [--axes N] [--jit] [--record FILE] [--replay FILE [--speed X] [--headless]]
+//   --config FILE  Tuning file, reloaded whenever it is saved (default axe_game.cfg; optional).
+//   --axes N       Play the "bullet hell" variant with N axes instead of one (at most kMaxReplayAxes).
+//   --jit          Just-in-time input: sample the keyboard as late as possible before each present.
+//   --record FILE  Save the inputs of every finished game to FILE (overwritten each game).
+//   --replay FILE  Watch a recorded game instead of playing. R restarts it.
+//   --speed X      Replay speed multiplier, e.g. 4 or 1000.
+//   --headless     With --replay: re-simulate without a window as fast as possible and check the score.
+//   --leaderboard HOST:PORT[/PATH]  Upload the replay of every finished game to a leaderboard server.
+//   --host PORT    Host an online versus game on UDP PORT (with --axes N for more axes).
+//   --join HOST:PORT  Join the versus game hosted at HOST:PORT.
+//   --bot          Let the built-in bot play, restarting after every game, for unattended soak runs.
+//   --telemetry TARGET  Append gameplay events to the file TARGET, or stream them to tcp:HOST:PORT.
+//   --mute         No sound.
+int main(int argc, char** argv) {
+    std::chrono::steady_clock::time_point launchTime = std::chrono::steady_clock::now();
+    gGame = new Game();
+    Game& game = *gGame;
+    game.launchTime = launchTime;
+    const char* replayPath = nullptr;
+    bool headless = false;
+    bool justInTime = false;
+    const char* leaderboardUrl = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--axes") == 0 && i + 1 < argc) {
+            game.axeCount = atoi(argv[++i]);
+            // Within what Replay::Decode accepts, so every game played can also be recorded and replayed.
+            game.axeCount = game.axeCount < 1 ? 1 : (game.axeCount > kMaxReplayAxes ? kMaxReplayAxes : game.axeCount);
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            game.recordPath = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            game.replaySpeed = static_cast<float>(atof(argv[++i]));
+        } else if (strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (strcmp(argv[i], "--jit") == 0) {
+            justInTime = true;
+        } else if (strcmp(argv[i], "--leaderboard") == 0 && i + 1 < argc) {
+            leaderboardUrl = argv[++i];
+        } else if (strcmp(argv[i], "--host") == 0 && i + 1 < argc) {
+            game.versusPort = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--join") == 0 && i + 1 < argc) {
+            game.versusAddress = argv[++i];
+        } else if (strcmp(argv[i], "--bot") == 0) {
+            game.botPlaying = true;
+        } else if (strcmp(argv[i], "--mute") == 0) {
+            game.muted = true;
+        } else if (strcmp(argv[i], "--telemetry") == 0 && i + 1 < argc) {
+            game.telemetryTarget = argv[++i];
+        } else if (strcmp(argv[i], "--config") == 0 && i + 1 < argc) {
+            game.configPath = argv[++i];
+        }
     }
 
+    // Tuning comes from the config file if there is one, otherwise the built-in defaults.
+    // The web build finds the shipped axe_game.cfg preloaded into its virtual file system.
+    GameConfig config;
+    std::string configError;
+    FILE* configFile = fopen(game.configPath, "rb");
+    if (configFile) {
+        fclose(configFile);
+        if (!LoadGameConfig(game.configPath, config, configError)) {
+            printf("%s: %s, using the default settings\n", game.configPath, configError.c_str());
+        }
+    }
+    if (headless && replayPath) {
+        return RunHeadlessReplay(replayPath, config);
+    }
+
+    // When watching a replay its header decides the axe count and seed; Load() has already checked the
+    // count against kMaxReplayAxes.
+    if (replayPath) {
+        game.replaying = game.replay.Load(replayPath);
+        if (!game.replaying) {
+            printf("%s: cannot read replay\n", replayPath);
+            return 1;
+        }
+        game.axeCount = game.replay.axeCount;
+    }
+    if (game.replaySpeed < 1.0f) {
+        game.replaySpeed = 1.0f;
+    }
+
+    // Ask for VSync so the frame rate follows the display (60, 144, 240 Hz...). There is deliberately
+    // no SetTargetFPS cap: the simulation runs on its own fixed tick, so rendering faster only makes
+    // motion smoother and never changes how the game plays. Per-state caps, and the idle screens'
+    // event-driven redraw, come from the config through StatePacer.
+    SetConfigFlags(FLAG_VSYNC_HINT);
+    // Initialize the game window with specified dimensions and title.
+    InitWindow(config.screenWidth, config.screenHeight, "Dan's Axe Game");
+    game.Init(config, justInTime, leaderboardUrl);
+
+#if defined(PLATFORM_WEB)
+    // Let the browser call us once per display refresh (requestAnimationFrame, hence the 0 fps).
+    // This never returns: the page keeps running frames after main() has handed over.
+    emscripten_set_main_loop(UpdateDrawFrame, 0, 1);
+#else
+    // Main game loop. Continues as long as the window is not closed.
+    while (!WindowShouldClose()) {
+        UpdateDrawFrame();
+    }
+#endif
+
+    // Label textures and streamed assets belong to the OpenGL context, so release them before
+    // closing the window.
+    game.Unload();
     CloseWindow(); // Close the window and release Raylib resources.
+    delete gGame;
+    gGame = nullptr;
     return 0;      // Return 0 to indicate successful execution.
-}
\ No newline at end of file
+}
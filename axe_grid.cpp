@@ -0,0 +1,118 @@
+#include "axe_grid.h"
+
+#include "axe_pool.h"   // Axe positions and sizes.
+#include "simulation.h" // SweptCircleHitsSquare for the narrow phase.
+
+#include <cmath> // fabsf for the speed bound.
+
+void AxeGrid::Init(int screenWidth, int screenHeight, int capacity) {
+    columns = (screenWidth + kGridCellSize - 1) / kGridCellSize;
+    rows = (screenHeight + kGridCellSize - 1) / kGridCellSize;
+    cellHead.assign(columns * rows, -1);
+    next.assign(capacity, -1);
+    prev.assign(capacity, -1);
+    cellOf.assign(capacity, -1);
+    maxLength = 0.0f;
+    lastPairCount = 0;
+    lastRelinkCount = 0;
+}
+
+int AxeGrid::CellFor(float x, float y) const {
+    // Axes may poke slightly past an edge for one step before they bounce back, so clamp into range.
+    int column = static_cast<int>(x) / kGridCellSize;
+    int row = static_cast<int>(y) / kGridCellSize;
+    if (column < 0) { column = 0; }
+    if (column >= columns) { column = columns - 1; }
+    if (row < 0) { row = 0; }
+    if (row >= rows) { row = rows - 1; }
+    return row * columns + column;
+}
+
+void AxeGrid::Link(int slot, int cell) {
+    int head = cellHead[cell];
+    prev[slot] = -1;
+    next[slot] = head;
+    if (head >= 0) {
+        prev[head] = slot;
+    }
+    cellHead[cell] = slot;
+    cellOf[slot] = cell;
+}
+
+void AxeGrid::Unlink(int slot) {
+    int cell = cellOf[slot];
+    if (prev[slot] >= 0) {
+        next[prev[slot]] = next[slot];
+    } else {
+        cellHead[cell] = next[slot];
+    }
+    if (next[slot] >= 0) {
+        prev[next[slot]] = prev[slot];
+    }
+    prev[slot] = -1;
+    next[slot] = -1;
+    cellOf[slot] = -1;
+}
+
+void AxeGrid::Update(const AxePool& axes) {
+    int relinked = 0;
+    float longest = 0.0f;
+    float fastest = 0.0f;
+    for (int i = 0; i < axes.highWater; ++i) {
+        // Track the largest and fastest axe so queries know how far away a relevant top-left
+        // corner can be.
+        longest = axes.length[i] > longest ? axes.length[i] : longest;
+        float speed = fabsf(axes.vx[i]) > fabsf(axes.vy[i]) ? fabsf(axes.vx[i]) : fabsf(axes.vy[i]);
+        fastest = speed > fastest ? speed : fastest;
+
+        int cell = axes.alive[i] ? CellFor(axes.x[i], axes.y[i]) : -1;
+        if (cell == cellOf[i]) {
+            continue; // Still in the same cell (or still dead): nothing to do.
+        }
+        if (cellOf[i] >= 0) {
+            Unlink(i);
+        }
+        if (cell >= 0) {
+            Link(i, cell);
+        }
+        ++relinked;
+    }
+    maxLength = longest;
+    maxSpeed = fastest;
+    lastRelinkCount = relinked;
+}
+
+int AxeGrid::FindCollision(const AxePool& axes, float prevCenterX, float prevCenterY, float centerX, float centerY,
+                           float radius, float deltaTime) {
+    // An axe can only touch the circle if its top-left corner lies within the bounding box of the
+    // circle's whole path, extended up and to the left by the longest axe and in every direction by
+    // the distance the fastest axe covers in one step.
+    float travel = maxSpeed * deltaTime;
+    float minX = (prevCenterX < centerX ? prevCenterX : centerX) - radius - maxLength - travel;
+    float minY = (prevCenterY < centerY ? prevCenterY : centerY) - radius - maxLength - travel;
+    float maxX = (prevCenterX > centerX ? prevCenterX : centerX) + radius + travel;
+    float maxY = (prevCenterY > centerY ? prevCenterY : centerY) + radius + travel;
+    int first = CellFor(minX, minY);
+    int last = CellFor(maxX, maxY);
+    int firstColumn = first % columns;
+    int firstRow = first / columns;
+    int lastColumn = last % columns;
+    int lastRow = last / columns;
+
+    int pairs = 0;
+    int hit = -1;
+    for (int row = firstRow; row <= lastRow && hit < 0; ++row) {
+        for (int column = firstColumn; column <= lastColumn && hit < 0; ++column) {
+            for (int slot = cellHead[row * columns + column]; slot >= 0; slot = next[slot]) {
+                ++pairs;
+                if (SweptCircleHitsSquare(prevCenterX, prevCenterY, centerX, centerY, radius, axes.prevX[slot],
+                                          axes.prevY[slot], axes.x[slot], axes.y[slot], axes.length[slot])) {
+                    hit = slot;
+                    break;
+                }
+            }
+        }
+    }
+    lastPairCount = pairs;
+    return hit;
+}
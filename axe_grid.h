@@ -0,0 +1,51 @@
+#ifndef AXE_GAME_AXE_GRID_H
+#define AXE_GAME_AXE_GRID_H
+
+// Broad-phase acceleration for player-vs-axe collision.
+// The playfield is split into a uniform grid of square cells. Each axe is filed under the cell that
+// holds its top-left corner, in an intrusive doubly-linked list per cell. Every step the grid only
+// relinks the axes that crossed into a different cell, and a collision query only visits the cells
+// the player's circle can reach, so the number of exact circle-vs-square tests stays small no matter
+// how many axes are in play.
+
+#include <vector> // Backing storage for cell heads and per-axe links.
+
+struct AxePool;
+
+const int kGridCellSize = 64; // Cell edge in pixels; comfortably larger than an axe.
+
+struct AxeGrid {
+    int columns = 0;             // Cells across the playfield.
+    int rows = 0;                // Cells down the playfield.
+    std::vector<int> cellHead;   // First axe slot in each cell, or -1.
+    std::vector<int> next;       // Next axe slot in the same cell, or -1.
+    std::vector<int> prev;       // Previous axe slot in the same cell, or -1.
+    std::vector<int> cellOf;     // Cell each slot is filed under, or -1 if it is not in the grid.
+    float maxLength = 0.0f;      // Largest axe side length seen by the last Update().
+    float maxSpeed = 0.0f;       // Largest per-axis axe speed seen by the last Update().
+
+    // Profiling counters from the most recent FindCollision() call.
+    int lastPairCount = 0;       // Player-vs-axe pairs that reached the exact (narrow-phase) test.
+    int lastRelinkCount = 0;     // Axes that changed cell during the most recent Update().
+
+    // Size the grid for a screenWidth x screenHeight playfield and 'capacity' axe slots, and empty it.
+    // Allocates; call when setting up a game, not per tick.
+    void Init(int screenWidth, int screenHeight, int capacity);
+
+    // Bring the grid up to date with the pool after its axes moved, spawned or despawned.
+    void Update(const AxePool& axes);
+
+    // Return the slot of an axe that touched the circle during the last 'deltaTime' step, or -1.
+    // The circle moved from (prevCenterX, prevCenterY) to (centerX, centerY); each axe moved from its
+    // previous to its current position. The query widens by how far any axe can travel in one step,
+    // and every candidate gets the swept SweptCircleHitsSquare test.
+    int FindCollision(const AxePool& axes, float prevCenterX, float prevCenterY, float centerX, float centerY,
+                      float radius, float deltaTime);
+
+    // Internal helpers.
+    int CellFor(float x, float y) const;
+    void Link(int slot, int cell);
+    void Unlink(int slot);
+};
+
+#endif // AXE_GAME_AXE_GRID_H
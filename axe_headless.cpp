@@ -0,0 +1,63 @@
+// Headless runner for Axe Game.
+// Plays many complete games through the simulation core without opening a window, which makes it
+// suitable for CI machines and balancing farms that have no GPU or X server.
+//
+// Usage: axe_headless [games] [seed] [axes] [player]
+//   player  "script" (the default) for the random scripted player, "bot" for the DodgeBot.
+
+#include "controller.h"
+#include "dodge_bot.h"
+#include "scripted_player.h"
+#include "simulation.h"
+
+#include <chrono>  // Wall-clock timing of the whole run.
+#include <cstdio>  // printf for the summary.
+#include <cstdlib> // strtoul for command-line arguments.
+#include <cstring> // strcmp for the player name.
+
+// Upper bound on the length of a single game so a lucky script cannot run forever (one hour).
+const int kMaxStepsPerGame = kTickRate * 60 * 60;
+
+int main(int argc, char** argv) {
+    unsigned long games = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 1000;
+    uint32_t seed = (argc > 2) ? static_cast<uint32_t>(strtoul(argv[2], nullptr, 10)) : 1u;
+    int axeCount = (argc > 3) ? atoi(argv[3]) : 1;
+    bool useBot = argc > 4 && strcmp(argv[4], "bot") == 0;
+
+    long long totalSteps = 0;
+    long long totalScore = 0;
+    int bestScore = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    World world;
+    DodgeBot bot;
+    for (unsigned long game = 0; game < games; ++game) {
+        // One World is reused for every game so its axe storage is only allocated once.
+        uint32_t gameSeed = seed + static_cast<uint32_t>(game) * 2654435761u;
+        world.Reset(axeCount, gameSeed);
+
+        // Deterministic for a given seed, so every run of the same command line plays the same games.
+        ScriptedPlayer script(gameSeed ^ 0x9E3779B9u);
+        bot.Reset();
+        Controller player = useBot ? MakeController("bot", bot) : MakeController("script", script);
+
+        int step = 0;
+        for (; step < kMaxStepsPerGame; ++step) {
+            if (world.Step(kTickSeconds, player.Next(world))) {
+                break;
+            }
+        }
+
+        totalSteps += step;
+        totalScore += world.score;
+        if (world.score > bestScore) {
+            bestScore = world.score;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("games=%lu axes=%d steps=%lld mean_score=%.2f best_score=%d seconds=%.3f games_per_sec=%.0f\n",
+           games, axeCount, totalSteps, games ? static_cast<double>(totalScore) / games : 0.0, bestScore,
+           seconds, seconds > 0.0 ? games / seconds : 0.0);
+    return 0;
+}
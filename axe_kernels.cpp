@@ -0,0 +1,248 @@
+#include "axe_kernels.h"
+
+#include <cstdlib> // getenv for the AXE_SIMD override.
+#include <cstring> // strcmp for kernel lookup.
+
+// Pick the SIMD flavours this compiler and architecture can build. AVX2 kernels are compiled with a
+// per-function target attribute, so the rest of the program keeps the baseline instruction set and
+// still runs on CPUs without AVX2.
+#if defined(__x86_64__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define AXE_KERNELS_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(__x86_64__) || defined(_M_X64)
+#define AXE_KERNELS_AVX2 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h> // __cpuid / __cpuidex / _xgetbv
+#define AXE_TARGET_AVX2
+#else
+#define AXE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+#if defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#define AXE_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Reference kernel: the same select-based loop AxePool has always used.
+static int MoveAxesScalar(const AxeArrays& axes, float screenWidth, float screenHeight, float deltaTime) {
+    float* __restrict px = axes.x;
+    float* __restrict py = axes.y;
+    float* __restrict pvx = axes.vx;
+    float* __restrict pvy = axes.vy;
+    const float* __restrict plength = axes.length;
+    float* __restrict pprevX = axes.prevX;
+    float* __restrict pprevY = axes.prevY;
+
+    int bounces = 0;
+    for (int i = 0; i < axes.count; ++i) {
+        pprevX[i] = px[i];
+        pprevY[i] = py[i];
+
+        float newX = px[i] + pvx[i] * deltaTime;
+        float newY = py[i] + pvy[i] * deltaTime;
+        px[i] = newX;
+        py[i] = newY;
+
+        // Same edge tests as Axe::Move, written as selects instead of branches.
+        bool bounceX = (newX + plength[i] > screenWidth) | (newX < 0.0f);
+        bool bounceY = (newY + plength[i] > screenHeight) | (newY < 0.0f);
+        pvx[i] = bounceX ? -pvx[i] : pvx[i];
+        pvy[i] = bounceY ? -pvy[i] : pvy[i];
+        bounces += bounceX | bounceY;
+    }
+    return bounces;
+}
+
+#if AXE_KERNELS_SSE2
+// 4 axes per iteration. The compare results are all-ones lanes where an axe is past an edge;
+// AND-ing them with the sign bit and XOR-ing into the speed negates exactly those lanes. Read as
+// integers the same lanes are -1, so subtracting them counts bounces per lane without a branch.
+static int MoveAxesSse2(const AxeArrays& axes, float screenWidth, float screenHeight, float deltaTime) {
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 width = _mm_set1_ps(screenWidth);
+    const __m128 height = _mm_set1_ps(screenHeight);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    __m128i bounces = _mm_setzero_si128();
+
+    for (int i = 0; i < axes.count; i += 4) {
+        __m128 x = _mm_loadu_ps(axes.x + i);
+        __m128 y = _mm_loadu_ps(axes.y + i);
+        __m128 vx = _mm_loadu_ps(axes.vx + i);
+        __m128 vy = _mm_loadu_ps(axes.vy + i);
+        __m128 length = _mm_loadu_ps(axes.length + i);
+        _mm_storeu_ps(axes.prevX + i, x);
+        _mm_storeu_ps(axes.prevY + i, y);
+
+        x = _mm_add_ps(x, _mm_mul_ps(vx, dt));
+        y = _mm_add_ps(y, _mm_mul_ps(vy, dt));
+
+        __m128 bounceX = _mm_or_ps(_mm_cmpgt_ps(_mm_add_ps(x, length), width), _mm_cmplt_ps(x, zero));
+        __m128 bounceY = _mm_or_ps(_mm_cmpgt_ps(_mm_add_ps(y, length), height), _mm_cmplt_ps(y, zero));
+        vx = _mm_xor_ps(vx, _mm_and_ps(bounceX, signBit));
+        vy = _mm_xor_ps(vy, _mm_and_ps(bounceY, signBit));
+        bounces = _mm_sub_epi32(bounces, _mm_castps_si128(_mm_or_ps(bounceX, bounceY)));
+
+        _mm_storeu_ps(axes.x + i, x);
+        _mm_storeu_ps(axes.y + i, y);
+        _mm_storeu_ps(axes.vx + i, vx);
+        _mm_storeu_ps(axes.vy + i, vy);
+    }
+    bounces = _mm_add_epi32(bounces, _mm_shuffle_epi32(bounces, _MM_SHUFFLE(1, 0, 3, 2)));
+    bounces = _mm_add_epi32(bounces, _mm_shuffle_epi32(bounces, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(bounces);
+}
+#endif
+
+#if AXE_KERNELS_AVX2
+// 8 axes per iteration, otherwise identical to the SSE2 kernel.
+AXE_TARGET_AVX2
+static int MoveAxesAvx2(const AxeArrays& axes, float screenWidth, float screenHeight, float deltaTime) {
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    const __m256 width = _mm256_set1_ps(screenWidth);
+    const __m256 height = _mm256_set1_ps(screenHeight);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    __m256i bounces = _mm256_setzero_si256();
+
+    for (int i = 0; i < axes.count; i += 8) {
+        __m256 x = _mm256_loadu_ps(axes.x + i);
+        __m256 y = _mm256_loadu_ps(axes.y + i);
+        __m256 vx = _mm256_loadu_ps(axes.vx + i);
+        __m256 vy = _mm256_loadu_ps(axes.vy + i);
+        __m256 length = _mm256_loadu_ps(axes.length + i);
+        _mm256_storeu_ps(axes.prevX + i, x);
+        _mm256_storeu_ps(axes.prevY + i, y);
+
+        x = _mm256_add_ps(x, _mm256_mul_ps(vx, dt));
+        y = _mm256_add_ps(y, _mm256_mul_ps(vy, dt));
+
+        __m256 bounceX = _mm256_or_ps(_mm256_cmp_ps(_mm256_add_ps(x, length), width, _CMP_GT_OQ),
+                                      _mm256_cmp_ps(x, zero, _CMP_LT_OQ));
+        __m256 bounceY = _mm256_or_ps(_mm256_cmp_ps(_mm256_add_ps(y, length), height, _CMP_GT_OQ),
+                                      _mm256_cmp_ps(y, zero, _CMP_LT_OQ));
+        vx = _mm256_xor_ps(vx, _mm256_and_ps(bounceX, signBit));
+        vy = _mm256_xor_ps(vy, _mm256_and_ps(bounceY, signBit));
+        bounces = _mm256_sub_epi32(bounces, _mm256_castps_si256(_mm256_or_ps(bounceX, bounceY)));
+
+        _mm256_storeu_ps(axes.x + i, x);
+        _mm256_storeu_ps(axes.y + i, y);
+        _mm256_storeu_ps(axes.vx + i, vx);
+        _mm256_storeu_ps(axes.vy + i, vy);
+    }
+    // Fold the eight lane counts down to one in registers, before the upper halves are cleared.
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(bounces), _mm256_extracti128_si256(bounces, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    int total = _mm_cvtsi128_si32(sum);
+    // Clear the upper YMM halves before returning to SSE code; otherwise every later SSE
+    // instruction in the caller pays an AVX/SSE transition penalty.
+    _mm256_zeroupper();
+    return total;
+}
+
+// AVX2 needs both CPU support and an OS that saves the YMM registers on context switches.
+static bool CpuSupportsAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    bool osSavesYmm = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 6) == 6);
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && (info[1] & (1 << 5));
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+#if AXE_KERNELS_NEON
+// 4 axes per iteration on ARM. Multiply and add are kept separate (no fused multiply-add) so the
+// results match the scalar kernel bit for bit.
+static int MoveAxesNeon(const AxeArrays& axes, float screenWidth, float screenHeight, float deltaTime) {
+    const float32x4_t dt = vdupq_n_f32(deltaTime);
+    const float32x4_t width = vdupq_n_f32(screenWidth);
+    const float32x4_t height = vdupq_n_f32(screenHeight);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const uint32x4_t signBit = vdupq_n_u32(0x80000000u);
+    uint32x4_t bounces = vdupq_n_u32(0);
+
+    for (int i = 0; i < axes.count; i += 4) {
+        float32x4_t x = vld1q_f32(axes.x + i);
+        float32x4_t y = vld1q_f32(axes.y + i);
+        float32x4_t vx = vld1q_f32(axes.vx + i);
+        float32x4_t vy = vld1q_f32(axes.vy + i);
+        float32x4_t length = vld1q_f32(axes.length + i);
+        vst1q_f32(axes.prevX + i, x);
+        vst1q_f32(axes.prevY + i, y);
+
+        x = vaddq_f32(x, vmulq_f32(vx, dt));
+        y = vaddq_f32(y, vmulq_f32(vy, dt));
+
+        uint32x4_t bounceX = vorrq_u32(vcgtq_f32(vaddq_f32(x, length), width), vcltq_f32(x, zero));
+        uint32x4_t bounceY = vorrq_u32(vcgtq_f32(vaddq_f32(y, length), height), vcltq_f32(y, zero));
+        vx = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vx), vandq_u32(bounceX, signBit)));
+        vy = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vy), vandq_u32(bounceY, signBit)));
+        bounces = vsubq_u32(bounces, vorrq_u32(bounceX, bounceY));
+
+        vst1q_f32(axes.x + i, x);
+        vst1q_f32(axes.y + i, y);
+        vst1q_f32(axes.vx + i, vx);
+        vst1q_f32(axes.vy + i, vy);
+    }
+    return static_cast<int>(vgetq_lane_u32(bounces, 0) + vgetq_lane_u32(bounces, 1) + vgetq_lane_u32(bounces, 2) +
+                            vgetq_lane_u32(bounces, 3));
+}
+#endif
+
+// Every kernel compiled into this binary, widest first, with a check for whether the CPU can run it.
+struct KernelEntry {
+    AxeKernel kernel;
+    bool (*supported)();
+};
+
+static bool Always() { return true; }
+
+static const KernelEntry kKernels[] = {
+#if AXE_KERNELS_AVX2
+    {{"avx2", MoveAxesAvx2}, CpuSupportsAvx2},
+#endif
+#if AXE_KERNELS_SSE2
+    {{"sse2", MoveAxesSse2}, Always},
+#endif
+#if AXE_KERNELS_NEON
+    {{"neon", MoveAxesNeon}, Always},
+#endif
+    {{"scalar", MoveAxesScalar}, Always},
+};
+
+const AxeKernel* FindAxeKernel(const char* name) {
+    for (const KernelEntry& entry : kKernels) {
+        if (strcmp(entry.kernel.name, name) == 0) {
+            return entry.supported() ? &entry.kernel : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+static const AxeKernel& DetectAxeKernel() {
+    const char* requested = getenv("AXE_SIMD");
+    if (requested) {
+        if (const AxeKernel* kernel = FindAxeKernel(requested)) {
+            return *kernel;
+        }
+    }
+    for (const KernelEntry& entry : kKernels) {
+        if (entry.supported()) {
+            return entry.kernel;
+        }
+    }
+    return kKernels[sizeof(kKernels) / sizeof(kKernels[0]) - 1].kernel; // Scalar is always last.
+}
+
+const AxeKernel& SelectAxeKernel() {
+    static const AxeKernel& selected = DetectAxeKernel(); // Detected once, thread-safe since C++11.
+    return selected;
+}
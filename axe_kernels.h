@@ -0,0 +1,44 @@
+#ifndef AXE_GAME_AXE_KERNELS_H
+#define AXE_GAME_AXE_KERNELS_H
+
+// Batch kernels that move and bounce many axes at once.
+// Each kernel implements exactly the rules of Axe::Move (integrate, then reflect the speed if the axe
+// is past an edge) over structure-of-arrays data. The SIMD versions replace the bounce branches with
+// compare masks that flip the sign bit of the speed, so every lane does the same work. The best kernel
+// the CPU supports is picked once at startup; the scalar kernel is always available as a fallback.
+
+// Every SIMD kernel processes this many axes per iteration (AVX2 width). AxePool pads its capacity to
+// a multiple of this, so kernels never need a scalar tail loop.
+const int kAxeLaneWidth = 8;
+
+// Raw views of the pool arrays a kernel reads and writes. 'count' is always a multiple of
+// kAxeLaneWidth; padding slots are zero-sized, motionless axes and are left unchanged.
+struct AxeArrays {
+    float* x;
+    float* y;
+    float* vx;
+    float* vy;
+    const float* length;
+    float* prevX;
+    float* prevY;
+    int count;
+};
+
+// Returns how many axes bounced off an edge (one count per axe, however many edges it hit), so sound
+// effects can follow bounces without another pass over the arrays.
+typedef int (*AxeMoveKernel)(const AxeArrays& axes, float screenWidth, float screenHeight, float deltaTime);
+
+struct AxeKernel {
+    const char* name;   // "scalar", "sse2", "avx2" or "neon".
+    AxeMoveKernel move; // Entry point.
+};
+
+// The kernel used by AxePool::Move. Chosen on first use: the widest instruction set this CPU
+// supports, unless the AXE_SIMD environment variable names another available kernel.
+const AxeKernel& SelectAxeKernel();
+
+// Look up a kernel by name, e.g. for benchmarks. Returns nullptr if it was not compiled in
+// or the CPU cannot run it.
+const AxeKernel* FindAxeKernel(const char* name);
+
+#endif // AXE_GAME_AXE_KERNELS_H
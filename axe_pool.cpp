@@ -0,0 +1,82 @@
+#include "axe_pool.h"
+
+#include "axe_kernels.h" // Batch move/bounce kernels used by Move().
+#include "simulation.h"  // The Axe value type returned by Get().
+
+void AxePool::Reserve(int count) {
+    // Pad to a whole number of SIMD lanes so the batch kernels never need a tail loop.
+    count = (count + kAxeLaneWidth - 1) / kAxeLaneWidth * kAxeLaneWidth;
+    if (count <= capacity) {
+        return;
+    }
+    x.resize(count, 0.0f);
+    y.resize(count, 0.0f);
+    vx.resize(count, 0.0f);
+    vy.resize(count, 0.0f);
+    length.resize(count, 0.0f);
+    prevX.resize(count, 0.0f);
+    prevY.resize(count, 0.0f);
+    alive.resize(count, 0);
+    freeList.resize(count, 0);
+    capacity = count;
+}
+
+void AxePool::Clear() {
+    for (int i = 0; i < highWater; ++i) {
+        Despawn(i);
+    }
+    freeCount = 0; // Every slot is below highWater 0 again, so the free-list is not needed.
+    highWater = 0;
+    liveCount = 0;
+}
+
+int AxePool::Spawn(float spawnX, float spawnY, float speedX, float speedY, float size) {
+    int slot;
+    if (freeCount > 0) {
+        slot = freeList[--freeCount]; // Reuse the most recently freed slot.
+    } else if (highWater < capacity) {
+        slot = highWater++;           // Otherwise take a slot that has never been used.
+    } else {
+        return -1;                    // Full: callers must Reserve() more up front.
+    }
+
+    x[slot] = spawnX;
+    y[slot] = spawnY;
+    vx[slot] = speedX;
+    vy[slot] = speedY;
+    length[slot] = size;
+    prevX[slot] = spawnX;
+    prevY[slot] = spawnY;
+    alive[slot] = 1;
+    ++liveCount;
+    return slot;
+}
+
+void AxePool::Despawn(int slot) {
+    if (!alive[slot]) {
+        return;
+    }
+    // A dead slot is a zero-sized, motionless axe at the origin. Move() can then run over every
+    // slot below highWater without checking 'alive': the slot never moves and never bounces.
+    x[slot] = 0.0f;
+    y[slot] = 0.0f;
+    vx[slot] = 0.0f;
+    vy[slot] = 0.0f;
+    length[slot] = 0.0f;
+    prevX[slot] = 0.0f;
+    prevY[slot] = 0.0f;
+    alive[slot] = 0;
+    freeList[freeCount++] = slot;
+    --liveCount;
+}
+
+int AxePool::Move(float screenWidth, float screenHeight, float deltaTime) {
+    // Round up to whole SIMD lanes; Reserve() guarantees the padding slots exist and are inert.
+    int count = (highWater + kAxeLaneWidth - 1) / kAxeLaneWidth * kAxeLaneWidth;
+    AxeArrays arrays = {x.data(), y.data(), vx.data(), vy.data(), length.data(), prevX.data(), prevY.data(), count};
+    return SelectAxeKernel().move(arrays, screenWidth, screenHeight, deltaTime);
+}
+
+Axe AxePool::Get(int slot) const {
+    return Axe{x[slot], y[slot], length[slot], vx[slot], vy[slot], prevX[slot], prevY[slot]};
+}
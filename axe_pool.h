@@ -0,0 +1,54 @@
+#ifndef AXE_GAME_AXE_POOL_H
+#define AXE_GAME_AXE_POOL_H
+
+// Structure-of-arrays storage for every axe in a game.
+// Instead of one Axe struct per obstacle, each property lives in its own contiguous float array, so
+// moving and bouncing thousands of axes is a single linear pass the compiler can vectorize. Slots are
+// recycled through a free-list and all storage is allocated up front by Reserve(), which means
+// spawning, despawning and stepping never touch the heap.
+
+#include <cstdint> // uint8_t for the alive flags.
+#include <vector>  // Backing storage for the component arrays.
+
+struct Axe;
+
+struct AxePool {
+    // Component arrays, all 'capacity' entries long. Slot i of every array describes the same axe.
+    std::vector<float> x;      // X position of each axe's top-left corner.
+    std::vector<float> y;      // Y position of each axe's top-left corner.
+    std::vector<float> vx;     // Horizontal speed in pixels per second.
+    std::vector<float> vy;     // Vertical speed in pixels per second.
+    std::vector<float> length; // Side length of each square axe.
+    std::vector<float> prevX;  // X position before the last step, for render interpolation.
+    std::vector<float> prevY;  // Y position before the last step, for render interpolation.
+    std::vector<uint8_t> alive; // 1 if the slot holds a live axe, 0 if it is free.
+
+    std::vector<int> freeList; // Stack of free slot indices below highWater.
+    int freeCount = 0;         // Number of valid entries at the bottom of freeList.
+    int highWater = 0;         // Slots at or above this index have never been used.
+    int liveCount = 0;         // Number of live axes.
+    int capacity = 0;          // Number of slots every array has room for (a multiple of kAxeLaneWidth).
+
+    // Make room for at least 'count' axes. This is the only function that allocates; call it
+    // when setting up a game, never from the per-tick path. Existing axes are kept.
+    void Reserve(int count);
+
+    // Remove every axe. Storage is kept for reuse.
+    void Clear();
+
+    // Add an axe and return its slot, or -1 if the pool is full.
+    int Spawn(float x, float y, float speedX, float speedY, float length);
+
+    // Remove the axe in 'slot' and make the slot available for the next Spawn().
+    void Despawn(int slot);
+
+    // Move every axe by 'deltaTime' seconds and bounce it off the edges of a
+    // screenWidth x screenHeight playfield. Same rules as Axe::Move, applied to the whole pool
+    // by the best batch kernel for this CPU (see axe_kernels.h). Returns how many axes bounced.
+    int Move(float screenWidth, float screenHeight, float deltaTime);
+
+    // Copy the axe in 'slot' out as a standalone Axe value.
+    Axe Get(int slot) const;
+};
+
+#endif // AXE_GAME_AXE_POOL_H
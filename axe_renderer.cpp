@@ -0,0 +1,78 @@
+#include "axe_renderer.h"
+
+#include "axe_pool.h"  // Axe positions and sizes.
+#include "obstacles.h" // Components of the other obstacle types.
+#include "rlgl.h"      // Low-level batch API underneath raylib's shape functions.
+
+// Quads written between buffer-limit checks. Small enough to fit rlgl's default batch many times over,
+// large enough that the check itself is negligible.
+const int kQuadsPerChunk = 1024;
+
+void DrawAxesBatched(const AxePool& axes, float alpha, Color color) {
+    int slot = 0;
+    while (slot < axes.highWater) {
+        int end = slot + kQuadsPerChunk < axes.highWater ? slot + kQuadsPerChunk : axes.highWater;
+
+        // Flush whatever is already batched if this chunk would not fit; rlgl then starts a new batch.
+        if (rlCheckBufferLimit(4 * (end - slot))) {
+            rlglDraw();
+        }
+
+        rlBegin(RL_QUADS);
+        rlColor4ub(color.r, color.g, color.b, color.a); // One color for the whole chunk.
+        for (; slot < end; ++slot) {
+            if (!axes.alive[slot]) {
+                continue;
+            }
+            float x = axes.prevX[slot] + (axes.x[slot] - axes.prevX[slot]) * alpha;
+            float y = axes.prevY[slot] + (axes.y[slot] - axes.prevY[slot]) * alpha;
+            float length = axes.length[slot];
+
+            // Counter-clockwise, matching the winding raylib uses for its own rectangles.
+            rlVertex2f(x, y);
+            rlVertex2f(x, y + length);
+            rlVertex2f(x + length, y + length);
+            rlVertex2f(x + length, y);
+        }
+        rlEnd();
+    }
+}
+
+// Write one quad: the square of side 'length' with top-left corner (x, y), rotated by (c, s) about
+// its center. The unrotated case is c = 1, s = 0. Colors are given per vertex, like raylib's own
+// shapes, so they survive the batch being flushed in between.
+static void ObstacleQuad(float x, float y, float length, float c, float s, Color color) {
+    if (rlCheckBufferLimit(4)) {
+        rlEnd();
+        rlglDraw();
+        rlBegin(RL_QUADS);
+    }
+    float half = length / 2.0f;
+    float centerX = x + half;
+    float centerY = y + half;
+    // Corners relative to the center, in the same counter-clockwise order as DrawAxesBatched.
+    const float cornerX[4] = {-half, -half, half, half};
+    const float cornerY[4] = {-half, half, half, -half};
+    for (int corner = 0; corner < 4; ++corner) {
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        rlVertex2f(centerX + c * cornerX[corner] - s * cornerY[corner],
+                   centerY + s * cornerX[corner] + c * cornerY[corner]);
+    }
+}
+
+void DrawObstaclesBatched(const EcsRegistry& obstacles, float alpha, Color spinningColor, Color homingColor) {
+    rlBegin(RL_QUADS);
+    obstacles.Each<Position, PrevPosition, Extent, Orientation>(
+        [&](const Position& position, const PrevPosition& previous, const Extent& extent,
+            const Orientation& orientation) {
+            ObstacleQuad(previous.x + (position.x - previous.x) * alpha, previous.y + (position.y - previous.y) * alpha,
+                         extent.length, orientation.cos, orientation.sin, spinningColor);
+        });
+    obstacles.Each<Position, PrevPosition, Extent>(
+        [&](const Position& position, const PrevPosition& previous, const Extent& extent) {
+            ObstacleQuad(previous.x + (position.x - previous.x) * alpha, previous.y + (position.y - previous.y) * alpha,
+                         extent.length, 1.0f, 0.0f, homingColor);
+        },
+        MaskOfTypes<Orientation>());
+    rlEnd();
+}
@@ -0,0 +1,23 @@
+#ifndef AXE_GAME_AXE_RENDERER_H
+#define AXE_GAME_AXE_RENDERER_H
+
+// Batched drawing of every axe in a pool.
+// DrawRectangle pays for a matrix push, translate and texture bind on every call, which adds up to
+// most of the frame once there are thousands of axes. This renderer instead writes all axe quads
+// straight into rlgl's dynamic vertex buffer inside a single rlBegin/rlEnd, so they go to the GPU
+// as one draw (or one per full buffer when the pool is larger than rlgl's batch).
+
+#include "raylib.h"
+
+struct AxePool;
+struct EcsRegistry;
+
+// Draw every live axe as a filled square, interpolated 'alpha' of a tick past its previous position.
+void DrawAxesBatched(const AxePool& axes, float alpha, Color color);
+
+// Draw system for the ECS obstacles (see obstacles.h): every entity with a position, previous
+// position and extent becomes one quad in the same kind of batch, rotated if it has an Orientation.
+// Spinning and homing axes get their own colors so the player can tell them apart.
+void DrawObstaclesBatched(const EcsRegistry& obstacles, float alpha, Color spinningColor, Color homingColor);
+
+#endif // AXE_GAME_AXE_RENDERER_H
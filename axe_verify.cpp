@@ -0,0 +1,207 @@
+// Server-side replay verifier.
+// Re-simulates submitted replays with the headless simulation core as fast as the CPU allows and
+// accepts a replay only if it reproduces its claimed score: same tuning hash and tick rate as the
+// rules being verified against, and a collision on exactly its last tick with exactly the claimed score. Files are spread
+// over a work-stealing thread pool with one World per worker, so throughput scales with the cores.
+//
+// Each FILE is either a single replay (see replay.h) or a leaderboard upload body holding a whole
+// batch of them (see leaderboard.h), so uploads can be checked exactly as they were received.
+//
+// Usage: axe_verify [-j threads] [-q] [--max-axes N] [--max-ticks N] [--config FILE] FILE...
+//   -j threads      Worker threads; 0 (the default) uses one per hardware thread.
+//   -q              Only print rejected replays and the summary.
+//   --max-axes N    Reject replays with more than N axes without simulating them (default 10000).
+//                   Replay::Decode already refuses more than kMaxReplayAxes, so a hostile submission
+//                   cannot make the verifier allocate without bound whatever N is.
+//   --max-ticks N   Likewise for replay length: longer replays are rejected as unreadable before any
+//                   input is decoded (default kMaxReplayTicks, a day of play). Upload batches are
+//                   bounded by kMaxLeaderboardBatchBytes.
+//   --config FILE   Verify against the rules in this tuning file instead of the built-in defaults.
+// Exit code: 0 if every replay was accepted, 1 otherwise.
+
+#include "game_config.h" // Optional tuning file.
+#include "leaderboard.h" // Upload batch decompression.
+#include "replay.h"      // Replay decoding and SimulateReplay.
+#include "thread_pool.h" // Parallel verification.
+
+#include <chrono>  // Throughput timing.
+#include <cstdio>  // File reading and the report.
+#include <cstdlib> // Command-line parsing.
+#include <cstring> // Magic comparisons and option names.
+#include <string>  // Per-replay report lines.
+#include <vector>  // Per-file results.
+
+enum Verdict {
+    ACCEPTED,
+    UNREADABLE,     // Not a replay, truncated, or failed its checksum.
+    WRONG_RULES,    // Recorded with different tuning or tick rate.
+    TOO_MANY_AXES,  // Above --max-axes.
+    CLAIM_MISMATCH  // Re-simulation does not end where the replay claims.
+};
+
+static const char* VerdictName(Verdict verdict) {
+    switch (verdict) {
+        case ACCEPTED: return "OK";
+        case UNREADABLE: return "REJECT unreadable";
+        case WRONG_RULES: return "REJECT rules mismatch";
+        case TOO_MANY_AXES: return "REJECT too many axes";
+        case CLAIM_MISMATCH: return "REJECT score mismatch";
+    }
+    return "?";
+}
+
+// Outcome for one replay inside a file.
+struct ReplayVerdict {
+    Verdict verdict;
+    int claimed;
+    int simulated;
+};
+
+static std::vector<uint8_t> ReadFile(const char* path) {
+    std::vector<uint8_t> bytes;
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return bytes;
+    }
+    uint8_t buffer[16384];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        bytes.insert(bytes.end(), buffer, buffer + read);
+    }
+    fclose(file);
+    return bytes;
+}
+
+static uint32_t GetU32(const uint8_t* data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+// What the verifier is willing to simulate; see --max-axes and --max-ticks.
+struct VerifyLimits {
+    int maxAxes;
+    uint32_t maxTicks;
+};
+
+static ReplayVerdict VerifyOne(const uint8_t* data, size_t size, const VerifyLimits& limits, World& world) {
+    Replay replay;
+    if (!replay.Decode(data, size, limits.maxTicks)) {
+        return ReplayVerdict{UNREADABLE, 0, 0};
+    }
+    if (replay.axeCount > limits.maxAxes) {
+        return ReplayVerdict{TOO_MANY_AXES, replay.claimedScore, 0};
+    }
+    ReplayResult result = SimulateReplay(replay, world);
+    Verdict verdict = result.verified ? ACCEPTED : (result.configMatches ? CLAIM_MISMATCH : WRONG_RULES);
+    return ReplayVerdict{verdict, replay.claimedScore, result.score};
+}
+
+// Verify every replay in one file: a single replay, or each entry of an upload batch.
+static std::vector<ReplayVerdict> VerifyFile(const char* path, const VerifyLimits& limits, World& world) {
+    std::vector<ReplayVerdict> verdicts;
+    std::vector<uint8_t> bytes = ReadFile(path);
+    if (bytes.size() < 8 || memcmp(bytes.data(), "AXLZ", 4) != 0) {
+        verdicts.push_back(VerifyOne(bytes.data(), bytes.size(), limits, world));
+        return verdicts;
+    }
+
+    std::vector<uint8_t> batch;
+    if (!LeaderboardDecompress(bytes.data() + 8, bytes.size() - 8, GetU32(bytes.data() + 4), batch) ||
+        batch.size() < 8 || memcmp(batch.data(), "AXLB", 4) != 0) {
+        verdicts.push_back(ReplayVerdict{UNREADABLE, 0, 0});
+        return verdicts;
+    }
+    size_t count = batch[6] | (batch[7] << 8);
+    size_t offset = 8;
+    for (size_t i = 0; i < count; ++i) {
+        if (offset + 4 > batch.size() || GetU32(batch.data() + offset) > batch.size() - offset - 4) {
+            verdicts.push_back(ReplayVerdict{UNREADABLE, 0, 0});
+            break;
+        }
+        size_t size = GetU32(batch.data() + offset);
+        verdicts.push_back(VerifyOne(batch.data() + offset + 4, size, limits, world));
+        if (verdicts.back().verdict == UNREADABLE) {
+            break; // A damaged entry says nothing good about the rest of the batch.
+        }
+        offset += 4 + size;
+    }
+    return verdicts;
+}
+
+// Per-worker state. The workers sit side by side in a std::vector, which does not over-align its
+// elements under C++14, so the trailing padding (a whole cache line) is what keeps the end of one
+// worker's state off the line the next worker starts on.
+struct VerifierWorker {
+    World world;
+    char padding[64];
+};
+
+int main(int argc, char** argv) {
+    int threadCount = 0;
+    bool quiet = false;
+    VerifyLimits limits = {10000, kMaxReplayTicks};
+    const char* configPath = nullptr;
+    std::vector<const char*> paths;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threadCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-q") == 0) {
+            quiet = true;
+        } else if (strcmp(argv[i], "--max-axes") == 0 && i + 1 < argc) {
+            limits.maxAxes = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--max-ticks") == 0 && i + 1 < argc) {
+            limits.maxTicks = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--config") == 0 && i + 1 < argc) {
+            configPath = argv[++i];
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (paths.empty()) {
+        printf("usage: axe_verify [-j threads] [-q] [--max-axes N] [--max-ticks N] [--config FILE] FILE...\n");
+        return 1;
+    }
+    GameConfig config;
+    std::string configError;
+    if (configPath && !LoadGameConfig(configPath, config, configError)) {
+        printf("%s: %s\n", configPath, configError.c_str());
+        return 1;
+    }
+
+    ThreadPool pool(threadCount);
+    std::vector<VerifierWorker> workers(pool.Size());
+    for (VerifierWorker& worker : workers) {
+        worker.world.config = config;
+    }
+    std::vector<std::vector<ReplayVerdict>> results(paths.size());
+
+    auto start = std::chrono::steady_clock::now();
+    // One file per task: files are independent and each writes only its own results slot.
+    pool.ParallelFor(static_cast<long long>(paths.size()), 1, [&](long long begin, long long end, int worker) {
+        for (long long i = begin; i < end; ++i) {
+            results[i] = VerifyFile(paths[i], limits, workers[worker].world);
+        }
+    });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    long long total = 0;
+    long long accepted = 0;
+    for (size_t file = 0; file < paths.size(); ++file) {
+        for (size_t entry = 0; entry < results[file].size(); ++entry) {
+            const ReplayVerdict& verdict = results[file][entry];
+            ++total;
+            accepted += verdict.verdict == ACCEPTED ? 1 : 0;
+            if (quiet && verdict.verdict == ACCEPTED) {
+                continue;
+            }
+            std::string name = paths[file];
+            if (results[file].size() > 1) {
+                name += "#" + std::to_string(entry);
+            }
+            printf("%s: claimed=%d simulated=%d -> %s\n", name.c_str(), verdict.claimed, verdict.simulated,
+                   VerdictName(verdict.verdict));
+        }
+    }
+    printf("replays=%lld accepted=%lld rejected=%lld threads=%d seconds=%.3f replays_per_sec=%.0f\n", total, accepted,
+           total - accepted, pool.Size(), seconds, seconds > 0.0 ? total / seconds : 0.0);
+    return accepted == total ? 0 : 1;
+}
@@ -0,0 +1,60 @@
+#ifndef AXE_GAME_BUILD_PROFILE_H
+#define AXE_GAME_BUILD_PROFILE_H
+
+// Build profiles: which gameplay constants are fixed when the game is compiled.
+// A development build reads everything from the GameConfig (and so from axe_game.cfg) at run time.
+// A fixed-profile build, such as the 800x450 arcade cabinet, bakes the playfield size and the
+// player speed into the movement code instead: World::Step instantiates Player::MoveWithin with
+// FixedBounds, so the edge clamps and bounces compare against constants. Such a build still loads
+// axe_game.cfg for everything else, and refuses a config whose fixed values differ, so the rules
+// (and the config hash replays carry) are always what the config says.
+//
+// Select a profile with its preprocessor flag:
+//   AXE_PROFILE_ARCADE   make PROFILE=arcade
+
+#include "simulation.h" // GameConfig and the bounds types.
+
+// Everything from the config. The default.
+struct RuntimeProfile {
+    static const bool kFixed = false;
+
+    static RuntimeBounds Bounds(const GameConfig& config) {
+        return RuntimeBounds{config.screenWidth, config.screenHeight};
+    }
+    static float PlayerSpeed(const GameConfig& config) { return config.playerSpeed; }
+};
+
+// The arcade cabinet: the shipped rules on its fixed 800x450 screen.
+struct ArcadeProfile {
+    static const bool kFixed = true;
+    static const int kScreenWidth = 800;
+    static const int kScreenHeight = 450;
+    static constexpr float kPlayerSpeed = 300.0f;
+
+    static constexpr FixedBounds<kScreenWidth, kScreenHeight> Bounds(const GameConfig&) {
+        return FixedBounds<kScreenWidth, kScreenHeight>();
+    }
+    static constexpr float PlayerSpeed(const GameConfig&) { return kPlayerSpeed; }
+};
+
+#if defined(AXE_PROFILE_ARCADE)
+typedef ArcadeProfile BuildProfile;
+#else
+typedef RuntimeProfile BuildProfile;
+#endif
+
+// Check that 'config' agrees with the values BuildProfile fixes. Returns nullptr if it does (always,
+// in a development build), or a message naming the fixed values.
+inline const char* CheckBuildProfile(const GameConfig& config) {
+#if defined(AXE_PROFILE_ARCADE)
+    if (config.screenWidth != ArcadeProfile::kScreenWidth || config.screenHeight != ArcadeProfile::kScreenHeight ||
+        config.playerSpeed != ArcadeProfile::kPlayerSpeed) {
+        return "this arcade build has screen_width = 800, screen_height = 450 and player_speed = 300 built in";
+    }
+#else
+    (void)config;
+#endif
+    return nullptr;
+}
+
+#endif // AXE_GAME_BUILD_PROFILE_H
@@ -0,0 +1,40 @@
+#ifndef AXE_GAME_CONTROLLER_H
+#define AXE_GAME_CONTROLLER_H
+
+// Pluggable source of player input.
+// The simulation only ever sees an InputMask per tick (see World::Step), so anything that can look
+// at the world and answer "which directions are held now?" can play the game: the keyboard, the
+// scripted player of the headless tools, or a bot. A Controller is that question as a plain
+// function pointer plus the object that answers it, the same shape as the AxeKernel table, so
+// callers can switch players at run time without the players sharing a base class.
+//
+//   DodgeBot bot;
+//   Controller player = MakeController("bot", bot);
+//   world.Step(kTickSeconds, player.Next(world));
+
+#include "simulation.h" // World and InputMask.
+
+struct Controller {
+    const char* name = nullptr;                                // "script", "bot", ...
+    void* self = nullptr;                                      // The object behind 'next'.
+    InputMask (*next)(void* self, const World& world) = nullptr;
+
+    // True if a player has been plugged in.
+    bool Connected() const { return next != nullptr; }
+
+    // Input for the tick about to be simulated in 'world'.
+    InputMask Next(const World& world) { return next(self, world); }
+};
+
+// Wrap any object with an 'InputMask Next(const World&)' member. The object must outlive the
+// Controller.
+template <typename Source>
+Controller MakeController(const char* name, Source& source) {
+    Controller controller;
+    controller.name = name;
+    controller.self = &source;
+    controller.next = [](void* self, const World& world) { return static_cast<Source*>(self)->Next(world); };
+    return controller;
+}
+
+#endif // AXE_GAME_CONTROLLER_H
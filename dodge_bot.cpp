@@ -0,0 +1,106 @@
+#include "dodge_bot.h"
+
+#include <cmath> // Distances for the clearance test.
+
+// Inputs the bot chooses from. Standing still comes first, so it wins ties and the bot only moves
+// when moving helps.
+static const InputMask kCandidateInputs[] = {
+    INPUT_NONE,
+    INPUT_RIGHT,
+    INPUT_LEFT,
+    INPUT_UP,
+    INPUT_DOWN,
+    static_cast<InputMask>(INPUT_RIGHT | INPUT_UP),
+    static_cast<InputMask>(INPUT_RIGHT | INPUT_DOWN),
+    static_cast<InputMask>(INPUT_LEFT | INPUT_UP),
+    static_cast<InputMask>(INPUT_LEFT | INPUT_DOWN),
+};
+
+// Score weights: every lookahead step survived outweighs any margin; margins beyond
+// kUsefulClearance do not matter, and the pull towards the middle only breaks near-ties.
+const float kSurvivedStepWeight = 1000.0f;
+const float kUsefulClearance = 100.0f;
+const float kCenterWeight = 0.1f;
+
+// Rotated squares fit inside a square this much larger, centered on the same point.
+const float kRotatedExtent = 1.4143f;
+
+// Gap between a circle and the edge of an axis-aligned square; zero or less if they touch.
+static float Clearance(const Player& player, const Axe& axe) {
+    float dx = fmaxf(fmaxf(axe.x - player.x, 0.0f), player.x - (axe.x + axe.length));
+    float dy = fmaxf(fmaxf(axe.y - player.y, 0.0f), player.y - (axe.y + axe.length));
+    return sqrtf(dx * dx + dy * dy) - player.radius;
+}
+
+void DodgeBot::GatherNearby(const World& world) {
+    // Only obstacles that could reach the player's neighbourhood within the lookahead matter.
+    // Axe speeds are per axis, so |vx| + |vy| bounds how far one can travel.
+    const Player& player = world.player;
+    float reach = world.config.playerSpeed * lookaheadSeconds + player.radius;
+    nearby.clear();
+    auto consider = [&](float x, float y, float length, float speedX, float speedY) {
+        float half = length * 0.5f;
+        float range = reach + half + (fabsf(speedX) + fabsf(speedY)) * lookaheadSeconds;
+        if (fabsf(x + half - player.x) <= range && fabsf(y + half - player.y) <= range) {
+            nearby.push_back(Axe{x, y, length, speedX, speedY, x, y});
+        }
+    };
+
+    const AxePool& axes = world.axes;
+    for (int i = 0; i < axes.highWater; ++i) {
+        if (axes.alive[i]) {
+            consider(axes.x[i], axes.y[i], axes.length[i], axes.vx[i], axes.vy[i]);
+        }
+    }
+    // Other obstacles may be rotated (or steer), so they are treated as their bounding square.
+    world.obstacles.Each<Position, Velocity, Extent>(
+        [&](const Position& position, const Velocity& velocity, const Extent& extent) {
+            float grown = extent.length * kRotatedExtent;
+            float offset = (extent.length - grown) * 0.5f;
+            consider(position.x + offset, position.y + offset, grown, velocity.x, velocity.y);
+        });
+}
+
+float DodgeBot::Score(const World& world, InputMask candidate) {
+    const GameConfig& config = world.config;
+    RuntimeBounds bounds = {config.screenWidth, config.screenHeight};
+    float step = lookaheadSeconds / lookaheadSteps;
+    Player ghost = world.player;
+    trial.assign(nearby.begin(), nearby.end()); // Keeps its capacity, so no allocation.
+
+    int survived = 0;
+    float closest = kUsefulClearance;
+    for (; survived < lookaheadSteps; ++survived) {
+        ghost.MoveWithin(bounds, config.playerSpeed, step, candidate);
+        bool hit = false;
+        for (Axe& axe : trial) {
+            axe.MoveWithin(bounds, step);
+            float clearance = Clearance(ghost, axe);
+            closest = clearance < closest ? clearance : closest;
+            hit = hit || clearance <= 0.0f;
+        }
+        if (hit) {
+            break;
+        }
+    }
+    float centerDistance = fabsf(ghost.x - config.screenWidth * 0.5f) + fabsf(ghost.y - config.screenHeight * 0.5f);
+    return survived * kSurvivedStepWeight + (closest > 0.0f ? closest : 0.0f) - centerDistance * kCenterWeight;
+}
+
+InputMask DodgeBot::Next(const World& world) {
+    if (holdTicks > 0) {
+        --holdTicks;
+        return input;
+    }
+    GatherNearby(world);
+    float bestScore = 0.0f;
+    for (size_t i = 0; i < sizeof(kCandidateInputs) / sizeof(kCandidateInputs[0]); ++i) {
+        float score = Score(world, kCandidateInputs[i]);
+        if (i == 0 || score > bestScore) {
+            bestScore = score;
+            input = kCandidateInputs[i];
+        }
+    }
+    holdTicks = replanTicks - 1;
+    return input;
+}
@@ -0,0 +1,50 @@
+#ifndef AXE_GAME_DODGE_BOT_H
+#define AXE_GAME_DODGE_BOT_H
+
+// Reference bot: reads where every axe is and where it is heading, and dodges.
+// Every few ticks it looks ahead a fraction of a second. For each of the nine possible inputs
+// (stand still or one of eight directions) it moves a copy of the player that way and moves copies
+// of the nearby obstacles with the real bounce rules (Axe::MoveWithin), and it keeps the input
+// that stays clear the longest, then the one with the widest margin, then the one nearest the
+// middle of the playfield, where there is room to dodge the next axe. It is deterministic, so a
+// bot game is reproducible from its seed, and it allocates only when the world grows, so it can
+// play unattended for hours.
+//
+// It is a Controller source (see controller.h); any number of bots can run on different threads
+// as long as each has its own.
+
+#include <vector> // Obstacles near the player.
+
+#include "simulation.h" // World, Axe and the bounds.
+
+struct DodgeBot {
+    // Tuning.
+    int replanTicks = 6;           // Ticks an input is held before the bot looks again (50 ms).
+    float lookaheadSeconds = 0.4f; // How far ahead each input is tried.
+    int lookaheadSteps = 8;        // Positions checked along the way.
+
+    // Input for the next tick.
+    InputMask Next(const World& world);
+
+    // Make room for 'obstacleCount' obstacles near the player, so Next() does not allocate. Call it
+    // when a game starts; Next() still grows the storage itself if it has to.
+    void Reserve(int obstacleCount) {
+        nearby.reserve(obstacleCount);
+        trial.reserve(obstacleCount);
+    }
+
+    // Forget the current plan, e.g. when a new game starts. Optional: a stale plan is only held for
+    // the rest of its replanTicks.
+    void Reset() { holdTicks = 0; }
+
+    // Internal state.
+    InputMask input = INPUT_NONE;
+    int holdTicks = 0;
+    std::vector<Axe> nearby;       // Copies of the obstacles close enough to matter, reused.
+    std::vector<Axe> trial;        // The same, moved along one candidate input.
+
+    void GatherNearby(const World& world);
+    float Score(const World& world, InputMask candidate);
+};
+
+#endif // AXE_GAME_DODGE_BOT_H
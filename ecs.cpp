@@ -0,0 +1,86 @@
+#include "ecs.h"
+
+int EcsRegistry::FindOrAddArchetype(ComponentMask mask, const int* ids, const size_t* sizes, size_t typeCount) {
+    for (size_t i = 0; i < archetypes.size(); ++i) {
+        if (archetypes[i].mask == mask) {
+            return static_cast<int>(i);
+        }
+    }
+    archetypes.push_back(Archetype());
+    Archetype& archetype = archetypes.back();
+    archetype.mask = mask;
+    for (size_t i = 0; i < typeCount; ++i) {
+        archetype.componentSize[ids[i]] = sizes[i];
+    }
+    return static_cast<int>(archetypes.size() - 1);
+}
+
+Entity EcsRegistry::AllocateEntity(int archetype, int row) {
+    Entity entity;
+    if (!freeIndices.empty()) {
+        entity.index = freeIndices.back();
+        freeIndices.pop_back();
+    } else {
+        entity.index = static_cast<uint32_t>(locations.size());
+        locations.push_back(Location{-1, 0, 0});
+    }
+    Location& location = locations[entity.index];
+    location.archetype = archetype;
+    location.row = row;
+    entity.generation = location.generation;
+    ++liveCount;
+    return entity;
+}
+
+void EcsRegistry::Destroy(Entity entity) {
+    if (!Alive(entity)) {
+        return;
+    }
+    Location& location = locations[entity.index];
+    Archetype& archetype = archetypes[location.archetype];
+    int row = location.row;
+    int last = archetype.count - 1;
+
+    // Move the last row into the hole so every column stays packed.
+    for (int id = 0; id < kMaxComponentTypes; ++id) {
+        if (!(archetype.mask & (1u << id))) {
+            continue;
+        }
+        size_t size = archetype.componentSize[id];
+        std::vector<unsigned char>& column = archetype.columns[id];
+        if (row != last) {
+            memcpy(column.data() + row * size, column.data() + last * size, size);
+        }
+        column.resize(last * size);
+    }
+    if (row != last) {
+        Entity moved = archetype.entities[last];
+        archetype.entities[row] = moved;
+        locations[moved.index].row = row;
+    }
+    archetype.entities.pop_back();
+    --archetype.count;
+
+    location.archetype = -1;
+    ++location.generation;
+    freeIndices.push_back(entity.index);
+    --liveCount;
+}
+
+void EcsRegistry::Clear() {
+    for (Archetype& archetype : archetypes) {
+        for (std::vector<unsigned char>& column : archetype.columns) {
+            column.clear();
+        }
+        archetype.entities.clear();
+        archetype.count = 0;
+    }
+    // Bump every generation so handles from before the Clear() are recognized as stale.
+    freeIndices.clear();
+    for (size_t i = locations.size(); i-- > 0;) {
+        locations[i].archetype = -1;
+        ++locations[i].generation;
+        freeIndices.push_back(static_cast<uint32_t>(i));
+    }
+    liveCount = 0;
+}
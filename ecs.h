@@ -0,0 +1,183 @@
+#ifndef AXE_GAME_ECS_H
+#define AXE_GAME_ECS_H
+
+// Lightweight archetype-based entity-component storage.
+// An entity is just a handle; its data lives in components, which are small plain structs. Every
+// distinct set of component types is an archetype, and each archetype keeps one packed array per
+// component type, so all entities made of the same components sit next to each other in memory.
+// A system is a loop over every archetype that has the components it needs, e.g.
+//
+//     registry.Each<Position, Velocity>([&](Position& position, Velocity& velocity) { ... });
+//
+// touches only dense arrays and never looks at entities without those components. A new kind of
+// obstacle is a new combination of components, not a new loop. Removing an entity moves the last
+// entity of its archetype into the hole, so the arrays stay packed; iteration order is deterministic
+// (archetypes in creation order, entities in insertion order after swap-removal).
+//
+// Components must be trivially copyable: they are moved around with memcpy and never destroyed.
+// Creating entities allocates; iterating them does not. Create everything when a game is set up.
+
+#include <cstdint>     // Masks and handles.
+#include <cstring>     // memcpy for moving component values.
+#include <type_traits> // Trivially copyable check.
+#include <vector>      // Packed component arrays.
+
+typedef uint32_t ComponentMask; // One bit per component type.
+const int kMaxComponentTypes = 32;
+
+// Every component type needs a unique id below kMaxComponentTypes, given with ECS_COMPONENT.
+template <typename T>
+struct ComponentId;
+#define ECS_COMPONENT(Type, Id)                                                             \
+    template <>                                                                             \
+    struct ComponentId<Type> {                                                              \
+        static_assert((Id) >= 0 && (Id) < kMaxComponentTypes, "component id out of range"); \
+        static_assert(std::is_trivially_copyable<Type>::value, "components must be PODs");  \
+        static const int value = (Id);                                                      \
+    }
+
+// Mask with the bit of every listed component type set.
+template <typename... Ts>
+ComponentMask MaskOfTypes() {
+    const ComponentMask bits[] = {0u, (1u << ComponentId<Ts>::value)...};
+    ComponentMask mask = 0;
+    for (ComponentMask bit : bits) {
+        mask |= bit;
+    }
+    return mask;
+}
+
+// Handle to an entity. Stays valid until the entity is destroyed; a handle to a destroyed entity is
+// recognized by its generation and never aliases a newer entity reusing the same index.
+struct Entity {
+    uint32_t index = 0xFFFFFFFFu;
+    uint32_t generation = 0;
+};
+
+// All entities made of exactly the component types in 'mask'.
+struct Archetype {
+    ComponentMask mask = 0;
+    int count = 0;                                          // Entities stored.
+    std::vector<Entity> entities;                           // Handle of the entity in each row.
+    std::vector<unsigned char> columns[kMaxComponentTypes]; // Packed values, for the types in 'mask'.
+    size_t componentSize[kMaxComponentTypes] = {};          // sizeof each component type in 'mask'.
+
+    template <typename T>
+    T* Column() {
+        return reinterpret_cast<T*>(columns[ComponentId<T>::value].data());
+    }
+    template <typename T>
+    const T* Column() const {
+        return reinterpret_cast<const T*>(columns[ComponentId<T>::value].data());
+    }
+};
+
+struct EcsRegistry {
+    std::vector<Archetype> archetypes;
+
+    // Where each entity lives, indexed by Entity::index.
+    struct Location {
+        int archetype;       // Index into 'archetypes', or -1 if the index is free.
+        int row;
+        uint32_t generation; // Bumped every time the index is released.
+    };
+    std::vector<Location> locations;
+    std::vector<uint32_t> freeIndices;
+    int liveCount = 0;
+
+    // Add an entity made of the given component values and return its handle.
+    template <typename... Ts>
+    Entity Create(const Ts&... components) {
+        const int ids[] = {ComponentId<Ts>::value...};
+        const size_t sizes[] = {sizeof(Ts)...};
+        int archetypeIndex = FindOrAddArchetype(MaskOfTypes<Ts...>(), ids, sizes, sizeof...(Ts));
+        Archetype& archetype = archetypes[archetypeIndex];
+        Entity entity = AllocateEntity(archetypeIndex, archetype.count);
+        const void* values[] = {&components...};
+        for (size_t i = 0; i < sizeof...(Ts); ++i) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(values[i]);
+            archetype.columns[ids[i]].insert(archetype.columns[ids[i]].end(), bytes, bytes + sizes[i]);
+        }
+        archetype.entities.push_back(entity);
+        ++archetype.count;
+        return entity;
+    }
+
+    // Remove an entity. Does nothing if the handle is stale.
+    void Destroy(Entity entity);
+
+    // Remove every entity. Archetypes and their storage are kept for reuse.
+    void Clear();
+
+    // True if 'entity' refers to a live entity.
+    bool Alive(Entity entity) const {
+        return entity.index < locations.size() && locations[entity.index].archetype >= 0 &&
+               locations[entity.index].generation == entity.generation;
+    }
+
+    // The entity's component of type T, or nullptr if it is dead or has no such component.
+    template <typename T>
+    T* Get(Entity entity) {
+        if (!Alive(entity)) {
+            return nullptr;
+        }
+        const Location& location = locations[entity.index];
+        Archetype& archetype = archetypes[location.archetype];
+        if (!(archetype.mask & MaskOfTypes<T>())) {
+            return nullptr;
+        }
+        return archetype.Column<T>() + location.row;
+    }
+
+    // Call body(Ts&...) for every entity that has all of Ts and none of the types in 'exclude'.
+    template <typename... Ts, typename Body>
+    void Each(Body body, ComponentMask exclude = 0) {
+        ComponentMask mask = MaskOfTypes<Ts...>();
+        for (Archetype& archetype : archetypes) {
+            if ((archetype.mask & mask) == mask && !(archetype.mask & exclude)) {
+                RunRows(archetype.count, body, archetype.Column<Ts>()...);
+            }
+        }
+    }
+
+    // Same as Each, but the body also receives the entity: body(Entity, Ts&...).
+    template <typename... Ts, typename Body>
+    void EachEntity(Body body, ComponentMask exclude = 0) {
+        ComponentMask mask = MaskOfTypes<Ts...>();
+        for (Archetype& archetype : archetypes) {
+            if ((archetype.mask & mask) == mask && !(archetype.mask & exclude)) {
+                RunEntityRows(archetype.count, archetype.entities.data(), body, archetype.Column<Ts>()...);
+            }
+        }
+    }
+
+    // Read-only iteration, for drawing.
+    template <typename... Ts, typename Body>
+    void Each(Body body, ComponentMask exclude = 0) const {
+        ComponentMask mask = MaskOfTypes<Ts...>();
+        for (const Archetype& archetype : archetypes) {
+            if ((archetype.mask & mask) == mask && !(archetype.mask & exclude)) {
+                RunRows(archetype.count, body, archetype.Column<Ts>()...);
+            }
+        }
+    }
+
+    // Internal helpers.
+    int FindOrAddArchetype(ComponentMask mask, const int* ids, const size_t* sizes, size_t typeCount);
+    Entity AllocateEntity(int archetype, int row);
+
+    template <typename Body, typename... Columns>
+    static void RunRows(int count, Body& body, Columns*... columns) {
+        for (int row = 0; row < count; ++row) {
+            body(columns[row]...);
+        }
+    }
+    template <typename Body, typename... Columns>
+    static void RunEntityRows(int count, const Entity* entities, Body& body, Columns*... columns) {
+        for (int row = 0; row < count; ++row) {
+            body(entities[row], columns[row]...);
+        }
+    }
+};
+
+#endif // AXE_GAME_ECS_H
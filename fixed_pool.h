@@ -0,0 +1,72 @@
+#ifndef AXE_GAME_FIXED_POOL_H
+#define AXE_GAME_FIXED_POOL_H
+
+// Fixed-capacity pool for long-lived entities such as effects and score popups.
+// Room for N values of T is part of the pool object itself, so a pool never allocates: Spawn() takes a
+// slot from a free-list (or the first never-used slot) and Despawn() puts it back. Slots stay put, so
+// a slot index is a stable handle for as long as the entity is alive. This is the array-of-structs
+// sibling of AxePool, for small counts of entities that are handled one at a time rather than in
+// vectorized batches; T is typically a plain struct like Player or Axe.
+
+template <typename T, int N>
+struct FixedPool {
+    T items[N];           // Entity storage. Only slots marked alive hold meaningful values.
+    bool alive[N] = {};   // True if the slot holds a live entity.
+    int freeList[N];      // Stack of free slot indices below highWater.
+    int freeCount = 0;    // Number of valid entries at the bottom of freeList.
+    int highWater = 0;    // Slots at or above this index have never been used.
+    int liveCount = 0;    // Number of live entities.
+
+    static int Capacity() { return N; }
+
+    // Add an entity and return its slot, or -1 if the pool is full.
+    int Spawn(const T& value) {
+        int slot;
+        if (freeCount > 0) {
+            slot = freeList[--freeCount];
+        } else if (highWater < N) {
+            slot = highWater++;
+        } else {
+            return -1;
+        }
+        items[slot] = value;
+        alive[slot] = true;
+        ++liveCount;
+        return slot;
+    }
+
+    // Remove the entity in 'slot' and make the slot available for the next Spawn().
+    void Despawn(int slot) {
+        if (slot < 0 || slot >= highWater || !alive[slot]) {
+            return;
+        }
+        alive[slot] = false;
+        freeList[freeCount++] = slot;
+        --liveCount;
+    }
+
+    // Remove every entity.
+    void Clear() {
+        for (int slot = 0; slot < highWater; ++slot) {
+            alive[slot] = false;
+        }
+        freeCount = 0;
+        highWater = 0;
+        liveCount = 0;
+    }
+
+    T& operator[](int slot) { return items[slot]; }
+    const T& operator[](int slot) const { return items[slot]; }
+
+    // Call body(entity, slot) for every live entity. The body may Despawn() the slot it is given.
+    template <typename Body>
+    void ForEach(Body body) {
+        for (int slot = 0; slot < highWater; ++slot) {
+            if (alive[slot]) {
+                body(items[slot], slot);
+            }
+        }
+    }
+};
+
+#endif // AXE_GAME_FIXED_POOL_H
@@ -0,0 +1,43 @@
+#include "frame_arena.h"
+
+#include <cstdarg> // va_list for Format.
+#include <cstdint> // uintptr_t for alignment.
+#include <cstdio>  // vsnprintf.
+
+void FrameArena::Init(size_t bytes) {
+    storage.assign(bytes, 0);
+    used = 0;
+    peak = 0;
+    overflows = 0;
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment) {
+    uintptr_t base = reinterpret_cast<uintptr_t>(storage.data());
+    size_t start = ((base + used + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1)) - base;
+    if (start > storage.size() || size > storage.size() - start) {
+        ++overflows;
+        return nullptr;
+    }
+    used = start + size;
+    peak = used > peak ? used : peak;
+    return storage.data() + start;
+}
+
+const char* FrameArena::Format(const char* format, ...) {
+    size_t available = storage.size() - used;
+    char* text = static_cast<char*>(Allocate(0, 1)); // Where the text will start, if it fits.
+    if (!text || available == 0) {
+        ++overflows;
+        return "";
+    }
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(text, available, format, args);
+    va_end(args);
+    if (length < 0 || static_cast<size_t>(length) >= available) {
+        ++overflows;
+        return "";
+    }
+    Allocate(static_cast<size_t>(length) + 1, 1); // Claim the text and its terminator.
+    return text;
+}
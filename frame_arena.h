@@ -0,0 +1,41 @@
+#ifndef AXE_GAME_FRAME_ARENA_H
+#define AXE_GAME_FRAME_ARENA_H
+
+// Bump allocator for data that only lives for one frame.
+// The arena owns a single block allocated by Init(). Allocate() hands out consecutive pieces of it and
+// Reset() takes them all back at once at the start of the next frame, so transient data such as HUD
+// strings costs a pointer increment instead of a trip to the heap. Nothing is ever freed individually
+// and no destructors run, which is why only trivially destructible types may live here.
+
+#include <cstddef>     // size_t, max_align_t.
+#include <type_traits> // Trivially destructible check for AllocateArray.
+#include <vector>      // Backing storage.
+
+struct FrameArena {
+    std::vector<unsigned char> storage; // The block every allocation comes from.
+    size_t used = 0;                    // Bytes handed out since the last Reset().
+    size_t peak = 0;                    // Most bytes ever in use at once, for sizing the arena.
+    int overflows = 0;                  // Requests refused because the arena was full.
+
+    // Allocate the backing block. The only call that touches the heap; do it once at startup.
+    void Init(size_t bytes);
+
+    // Release everything handed out since the last Reset(). Call once per frame.
+    void Reset() { used = 0; }
+
+    // Return 'size' bytes aligned to 'alignment' (a power of two), or nullptr if the arena is full.
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // Room for 'count' values of a trivially destructible type, uninitialized, or nullptr if full.
+    template <typename T>
+    T* AllocateArray(int count) {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena never runs destructors");
+        return static_cast<T*>(Allocate(sizeof(T) * static_cast<size_t>(count), alignof(T)));
+    }
+
+    // printf into the arena. Valid until the next Reset(). Returns "" (never nullptr) if the text does
+    // not fit, so the result can always be passed straight to DrawText.
+    const char* Format(const char* format, ...);
+};
+
+#endif // AXE_GAME_FRAME_ARENA_H
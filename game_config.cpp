@@ -0,0 +1,366 @@
+#include "game_config.h"
+
+#include "build_profile.h" // Values fixed by the build.
+
+#include <chrono>  // Poll interval and save debounce.
+#include <cmath>   // isfinite/fabsf for float values.
+#include <cstdio>  // Reading the file.
+#include <cstdlib> // strtol/strtof.
+#include <cstring> // strcmp for key lookup.
+
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+#include <sys/stat.h>
+
+// How often the watcher checks for a stop request (and, without OS notifications, for a new mtime).
+const std::chrono::milliseconds kWatchInterval(250);
+// Editors often save in several steps (truncate, write, rename); wait this long after the first
+// notification so the file is complete before it is read.
+const std::chrono::milliseconds kSaveDebounce(50);
+
+// Every key the file may set, with the GameConfig member it sets.
+struct IntKey {
+    const char* name;
+    int GameConfig::*field;
+};
+struct FloatKey {
+    const char* name;
+    float GameConfig::*field;
+};
+
+static const IntKey kIntKeys[] = {
+    {"screen_width", &GameConfig::screenWidth},
+    {"screen_height", &GameConfig::screenHeight},
+    {"player_radius", &GameConfig::playerRadius},
+    {"axe_start_x", &GameConfig::axeStartX},
+    {"axe_start_y", &GameConfig::axeStartY},
+    {"axe_length", &GameConfig::axeLength},
+    {"speed_ramp_interval", &GameConfig::speedRampInterval},
+    {"bullet_hell_spawn_height", &GameConfig::bulletHellSpawnHeight},
+    {"spinning_axes", &GameConfig::spinningAxes},
+    {"homing_axes", &GameConfig::homingAxes},
+    {"playing_fps", &GameConfig::playingFps},
+    {"menu_fps", &GameConfig::menuFps},
+    {"game_over_fps", &GameConfig::gameOverFps},
+    {"idle_redraw_ms", &GameConfig::idleRedrawMs},
+};
+static const FloatKey kFloatKeys[] = {
+    {"player_speed", &GameConfig::playerSpeed},
+    {"axe_start_speed_x", &GameConfig::axeStartSpeedX},
+    {"axe_start_speed_y", &GameConfig::axeStartSpeedY},
+    {"speed_ramp_factor", &GameConfig::speedRampFactor},
+    {"max_axe_speed_x", &GameConfig::maxAxeSpeedX},
+    {"max_axe_speed_y", &GameConfig::maxAxeSpeedY},
+    {"spin_speed", &GameConfig::spinSpeed},
+    {"homing_speed", &GameConfig::homingSpeed},
+    {"homing_turn_rate", &GameConfig::homingTurnRate},
+};
+
+// Reject combinations the simulation cannot play sensibly. Returns nullptr if 'config' is fine.
+static const char* ValidateGameConfig(const GameConfig& config) {
+    const float kMaxSpeed = 100000.0f;
+    if (config.screenWidth < 100 || config.screenWidth > 8192 || config.screenHeight < 100 ||
+        config.screenHeight > 8192) {
+        return "screen size must be between 100 and 8192 pixels";
+    }
+    int shortSide = config.screenWidth < config.screenHeight ? config.screenWidth : config.screenHeight;
+    if (config.playerRadius < 1 || config.playerRadius * 2 > shortSide) {
+        return "player_radius must be at least 1 and fit on the screen";
+    }
+    if (config.axeLength < 1 || config.axeLength > shortSide) {
+        return "axe_length must be at least 1 and fit on the screen";
+    }
+    if (config.axeStartX < 0 || config.axeStartX > config.screenWidth - config.axeLength || config.axeStartY < 0 ||
+        config.axeStartY > config.screenHeight - config.axeLength) {
+        return "the axe must start fully on the screen";
+    }
+    if (config.bulletHellSpawnHeight < config.axeLength || config.bulletHellSpawnHeight > config.screenHeight) {
+        return "bullet_hell_spawn_height must be between axe_length and screen_height";
+    }
+    if (config.speedRampInterval < 1) {
+        return "speed_ramp_interval must be at least 1";
+    }
+    if (!(config.speedRampFactor > 0.0f && config.speedRampFactor <= 10.0f)) {
+        return "speed_ramp_factor must be greater than 0 and at most 10";
+    }
+    if (config.spinningAxes < 0 || config.spinningAxes > 1000 || config.homingAxes < 0 || config.homingAxes > 1000) {
+        return "spinning_axes and homing_axes must be between 0 and 1000";
+    }
+    if (config.playingFps < 0 || config.playingFps > 1000 || config.menuFps < 0 || config.menuFps > 1000 ||
+        config.gameOverFps < 0 || config.gameOverFps > 1000) {
+        return "playing_fps, menu_fps and game_over_fps must be between 0 and 1000";
+    }
+    if (config.idleRedrawMs < 10 || config.idleRedrawMs > 10000) {
+        return "idle_redraw_ms must be between 10 and 10000";
+    }
+    if (const char* problem = CheckBuildProfile(config)) {
+        return problem;
+    }
+    if (!(fabsf(config.spinSpeed) <= 100.0f)) {
+        return "spin_speed must be between -100 and 100";
+    }
+    if (!(config.homingTurnRate >= 0.0f && config.homingTurnRate <= 1000.0f)) {
+        return "homing_turn_rate must be between 0 and 1000";
+    }
+    // Start speeds may be negative (an axe heading left or up); their magnitude is what counts.
+    const float speeds[] = {config.playerSpeed,  fabsf(config.axeStartSpeedX), fabsf(config.axeStartSpeedY),
+                            config.maxAxeSpeedX, config.maxAxeSpeedY,          config.homingSpeed};
+    for (float speed : speeds) {
+        if (!std::isfinite(speed) || speed < 0.0f || speed > kMaxSpeed) {
+            return "speeds and speed caps must be between 0 and 100000";
+        }
+    }
+    return nullptr;
+}
+
+static bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+bool ParseGameConfig(const char* text, GameConfig& config, std::string& error) {
+    GameConfig parsed; // Defaults for everything the file does not mention.
+    int lineNumber = 0;
+    for (const char* line = text; *line;) {
+        const char* lineEnd = strchr(line, '\n');
+        if (!lineEnd) {
+            lineEnd = line + strlen(line);
+        }
+        ++lineNumber;
+        std::string content(line, lineEnd);
+        line = *lineEnd ? lineEnd + 1 : lineEnd;
+
+        size_t comment = content.find('#');
+        if (comment != std::string::npos) {
+            content.erase(comment);
+        }
+        size_t first = 0;
+        while (first < content.size() && IsSpace(content[first])) {
+            ++first;
+        }
+        if (first == content.size()) {
+            continue; // Blank or comment-only line.
+        }
+        size_t equals = content.find('=');
+        if (equals == std::string::npos) {
+            error = "line " + std::to_string(lineNumber) + ": expected key = value";
+            return false;
+        }
+        size_t keyEnd = equals;
+        while (keyEnd > first && IsSpace(content[keyEnd - 1])) {
+            --keyEnd;
+        }
+        std::string key = content.substr(first, keyEnd - first);
+        const char* value = content.c_str() + equals + 1;
+
+        char* end = nullptr;
+        bool known = false;
+        bool valid = false;
+        for (const IntKey& entry : kIntKeys) {
+            if (key == entry.name) {
+                long number = strtol(value, &end, 10);
+                known = true;
+                valid = end != value && number >= -1000000 && number <= 1000000;
+                parsed.*entry.field = static_cast<int>(number);
+            }
+        }
+        for (const FloatKey& entry : kFloatKeys) {
+            if (key == entry.name) {
+                float number = strtof(value, &end);
+                known = true;
+                valid = end != value;
+                parsed.*entry.field = number;
+            }
+        }
+        if (!known) {
+            error = "line " + std::to_string(lineNumber) + ": unknown key '" + key + "'";
+            return false;
+        }
+        while (valid && *end && IsSpace(*end)) {
+            ++end;
+        }
+        if (!valid || *end) {
+            error = "line " + std::to_string(lineNumber) + ": bad value for '" + key + "'";
+            return false;
+        }
+    }
+
+    if (const char* problem = ValidateGameConfig(parsed)) {
+        error = problem;
+        return false;
+    }
+    config = parsed;
+    return true;
+}
+
+bool LoadGameConfig(const char* path, GameConfig& config, std::string& error) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        error = "cannot read file";
+        return false;
+    }
+    std::string text;
+    char buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        text.append(buffer, read);
+    }
+    fclose(file);
+    return ParseGameConfig(text.c_str(), config, error);
+}
+
+void ConfigWatcher::Start(const char* filePath) {
+    Stop();
+    path = filePath;
+    stopping = false;
+    ready = false;
+    thread = std::thread(&ConfigWatcher::Run, this);
+}
+
+void ConfigWatcher::Stop() {
+    if (thread.joinable()) {
+        stopping = true;
+        thread.join(); // The thread checks 'stopping' at least every kWatchInterval.
+    }
+}
+
+bool ConfigWatcher::TakeUpdate(ConfigUpdate& update) {
+    if (!ready.load(std::memory_order_acquire)) {
+        return false; // The common case: one atomic load per frame.
+    }
+    std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return false;
+    }
+    update = latest;
+    ready = false;
+    return true;
+}
+
+void ConfigWatcher::Reload() {
+    std::this_thread::sleep_for(kSaveDebounce);
+    ConfigUpdate update;
+    update.ok = LoadGameConfig(path.c_str(), update.config, update.error);
+    std::lock_guard<std::mutex> lock(mutex);
+    latest = update;
+    ready.store(true, std::memory_order_release);
+}
+
+// Split a path into its directory ("." if none) and file name.
+static void SplitPath(const std::string& path, std::string& directory, std::string& name) {
+    size_t slash = path.find_last_of("/\\");
+    directory = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+    name = slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+void ConfigWatcher::Run() {
+    std::string directory;
+    std::string name;
+    SplitPath(path, directory, name);
+
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+    // Watch the directory rather than the file: editors that save by writing a new file and
+    // renaming it over the old one would otherwise silently end the watch.
+    int notify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (notify >= 0 && inotify_add_watch(notify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) >= 0) {
+        alignas(inotify_event) char buffer[4096];
+        while (!stopping) {
+            pollfd waitFor = {notify, POLLIN, 0};
+            if (poll(&waitFor, 1, static_cast<int>(kWatchInterval.count())) <= 0) {
+                continue;
+            }
+            bool changed = false;
+            ssize_t length;
+            while ((length = read(notify, buffer, sizeof(buffer))) > 0) {
+                for (char* at = buffer; at < buffer + length;) {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(at);
+                    changed = changed || (event->len > 0 && name == event->name);
+                    at += sizeof(inotify_event) + event->len;
+                }
+            }
+            if (changed) {
+                Reload();
+            }
+        }
+        close(notify);
+        return;
+    }
+    if (notify >= 0) {
+        close(notify);
+    }
+#elif defined(_WIN32)
+    HANDLE handle = CreateFileA(directory.c_str(), FILE_LIST_DIRECTORY,
+                                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                                FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+    HANDLE event = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    if (handle != INVALID_HANDLE_VALUE && event) {
+        wchar_t wideName[MAX_PATH];
+        int wideLength = MultiByteToWideChar(CP_UTF8, 0, name.c_str(), -1, wideName, MAX_PATH) - 1;
+        alignas(DWORD) BYTE buffer[4096];
+        while (!stopping) {
+            OVERLAPPED overlapped = {};
+            overlapped.hEvent = event;
+            ResetEvent(event);
+            if (!ReadDirectoryChangesW(handle, buffer, sizeof(buffer), FALSE,
+                                       FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME, nullptr,
+                                       &overlapped, nullptr)) {
+                break;
+            }
+            while (!stopping && WaitForSingleObject(event, static_cast<DWORD>(kWatchInterval.count())) == WAIT_TIMEOUT) {
+            }
+            DWORD length = 0;
+            if (stopping) {
+                CancelIo(handle);
+                GetOverlappedResult(handle, &overlapped, &length, TRUE);
+                break;
+            }
+            if (!GetOverlappedResult(handle, &overlapped, &length, FALSE)) {
+                continue;
+            }
+            bool changed = length == 0; // Zero bytes: the buffer overflowed, so assume our file changed.
+            for (BYTE* at = buffer; length > 0;) {
+                const FILE_NOTIFY_INFORMATION* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(at);
+                int infoLength = static_cast<int>(info->FileNameLength / sizeof(wchar_t));
+                changed = changed || (infoLength == wideLength &&
+                                      CompareStringOrdinal(info->FileName, infoLength, wideName, wideLength, TRUE) ==
+                                          CSTR_EQUAL);
+                if (info->NextEntryOffset == 0) {
+                    break;
+                }
+                at += info->NextEntryOffset;
+            }
+            if (changed) {
+                Reload();
+            }
+        }
+        CloseHandle(event);
+        CloseHandle(handle);
+        return;
+    }
+    if (event) {
+        CloseHandle(event);
+    }
+    if (handle != INVALID_HANDLE_VALUE) {
+        CloseHandle(handle);
+    }
+#endif
+
+    // Portable fallback: poll the modification time and size.
+    struct stat info;
+    bool existed = stat(path.c_str(), &info) == 0;
+    long long lastTime = existed ? static_cast<long long>(info.st_mtime) : 0;
+    long long lastSize = existed ? static_cast<long long>(info.st_size) : -1;
+    while (!stopping) {
+        std::this_thread::sleep_for(kWatchInterval);
+        if (stat(path.c_str(), &info) != 0) {
+            continue;
+        }
+        if (static_cast<long long>(info.st_mtime) != lastTime || static_cast<long long>(info.st_size) != lastSize) {
+            lastTime = static_cast<long long>(info.st_mtime);
+            lastSize = static_cast<long long>(info.st_size);
+            Reload();
+        }
+    }
+}
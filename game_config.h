@@ -0,0 +1,60 @@
+#ifndef AXE_GAME_GAME_CONFIG_H
+#define AXE_GAME_GAME_CONFIG_H
+
+// Loading GameConfig from a text file, and watching that file for edits.
+// The file is a list of "key = value" lines; '#' starts a comment. Keys are the GameConfig field
+// names in snake_case (see axe_game.cfg for the full list with defaults). Any key left out keeps
+// its default, so deleting a line reverts it.
+//
+// ConfigWatcher notices saves with inotify on Linux, ReadDirectoryChangesW on Windows, and by
+// polling the modification time elsewhere. It reads and parses the file on its own thread; the game
+// only picks up the finished result between ticks, so an edit never stalls a frame.
+
+#include <atomic>  // Flags shared with the watcher thread.
+#include <mutex>   // Guards the finished update.
+#include <string>  // Paths and error messages.
+#include <thread>  // Watcher thread.
+
+#include "simulation.h" // GameConfig.
+
+// Parse config text into 'config', starting from the defaults. Returns false and describes the
+// first problem in 'error' (with its line number) if a line is malformed or a value is out of range;
+// 'config' is left unchanged in that case.
+bool ParseGameConfig(const char* text, GameConfig& config, std::string& error);
+
+// Read and parse a config file. Returns false if it cannot be read or does not parse.
+bool LoadGameConfig(const char* path, GameConfig& config, std::string& error);
+
+// Result of reloading the watched file.
+struct ConfigUpdate {
+    bool ok;           // True if the file parsed; 'config' is then the new configuration.
+    GameConfig config;
+    std::string error; // Why the file was rejected, if !ok.
+};
+
+struct ConfigWatcher {
+    // Start watching 'path'. The file does not have to exist yet.
+    void Start(const char* path);
+
+    // Stop the watcher thread. Called by the destructor.
+    void Stop();
+
+    ~ConfigWatcher() { Stop(); }
+
+    // Hand over the result of the latest reload, if there is one the caller has not seen.
+    // Never waits for the watcher: if it is busy publishing, the update is picked up next frame.
+    bool TakeUpdate(ConfigUpdate& update);
+
+    // Internal state.
+    std::string path;
+    std::thread thread;
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> ready{false};   // 'latest' holds an update not yet taken.
+    std::mutex mutex;                 // Guards 'latest'.
+    ConfigUpdate latest;
+
+    void Run();
+    void Reload();
+};
+
+#endif // AXE_GAME_GAME_CONFIG_H
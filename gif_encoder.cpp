@@ -0,0 +1,154 @@
+#include "gif_encoder.h"
+
+#include <algorithm> // Clearing the dictionary.
+
+// LZW codes are at most 12 bits wide, so the dictionary holds at most 4096 strings before the
+// encoder has to start over with a clear code.
+const int kGifMaxCodes = 4096;
+
+static void PutU16(std::vector<uint8_t>& out, int value) {
+    out.push_back(static_cast<uint8_t>(value & 0xFF));
+    out.push_back(static_cast<uint8_t>((value >> 8) & 0xFF));
+}
+
+// Bits per palette index: the smallest power of two holding 'colorCount' colors, and never less than
+// 2, the smallest LZW code size GIF allows.
+static int PaletteBits(int colorCount) {
+    int bits = 2;
+    while ((1 << bits) < colorCount && bits < 8) {
+        ++bits;
+    }
+    return bits;
+}
+
+// Packs variable-width codes least significant bit first, as GIF wants, into data sub-blocks of at
+// most 255 bytes, each prefixed with its length.
+struct GifBitWriter {
+    std::vector<uint8_t>& out;
+    uint32_t bits = 0;
+    int bitCount = 0;
+    uint8_t block[255];
+    int blockSize = 0;
+
+    explicit GifBitWriter(std::vector<uint8_t>& target) : out(target) {}
+
+    void Write(int code, int width) {
+        bits |= static_cast<uint32_t>(code) << bitCount;
+        bitCount += width;
+        while (bitCount >= 8) {
+            PutByte(static_cast<uint8_t>(bits & 0xFF));
+            bits >>= 8;
+            bitCount -= 8;
+        }
+    }
+
+    void PutByte(uint8_t byte) {
+        block[blockSize++] = byte;
+        if (blockSize == 255) {
+            FlushBlock();
+        }
+    }
+
+    void FlushBlock() {
+        if (blockSize > 0) {
+            out.push_back(static_cast<uint8_t>(blockSize));
+            out.insert(out.end(), block, block + blockSize);
+            blockSize = 0;
+        }
+    }
+
+    // Write out the last partial byte and block, then the empty block that ends the image data.
+    void Finish() {
+        if (bitCount > 0) {
+            PutByte(static_cast<uint8_t>(bits & 0xFF));
+            bits = 0;
+            bitCount = 0;
+        }
+        FlushBlock();
+        out.push_back(0);
+    }
+};
+
+void WriteGifHeader(std::vector<uint8_t>& out, int width, int height, const GifColor* palette, int colorCount) {
+    int bits = PaletteBits(colorCount);
+    const char* signature = "GIF89a";
+    out.insert(out.end(), signature, signature + 6);
+    PutU16(out, width);
+    PutU16(out, height);
+    out.push_back(static_cast<uint8_t>(0x80 | ((bits - 1) << 4) | (bits - 1))); // Global palette of 2^bits.
+    out.push_back(0); // Background color index.
+    out.push_back(0); // Square pixels.
+    for (int i = 0; i < (1 << bits); ++i) {
+        GifColor color = i < colorCount ? palette[i] : GifColor{0, 0, 0};
+        out.push_back(color.r);
+        out.push_back(color.g);
+        out.push_back(color.b);
+    }
+
+    // NETSCAPE2.0 application extension: loop forever.
+    const uint8_t loop[] = {0x21, 0xFF, 0x0B, 'N', 'E', 'T', 'S', 'C', 'A', 'P', 'E', '2', '.', '0', 0x03, 0x01,
+                            0x00, 0x00, 0x00};
+    out.insert(out.end(), loop, loop + sizeof(loop));
+}
+
+void EncodeGifFrame(const uint8_t* pixels, int width, int height, int colorCount, int delayCentiseconds,
+                    std::vector<uint8_t>& out) {
+    int bits = PaletteBits(colorCount);
+    int colors = 1 << bits;
+
+    // Graphic control extension (the frame's delay), then an image descriptor covering the whole
+    // canvas, using the global palette.
+    const uint8_t control[] = {0x21, 0xF9, 0x04, 0x00};
+    out.insert(out.end(), control, control + sizeof(control));
+    PutU16(out, delayCentiseconds);
+    out.push_back(0); // No transparent color.
+    out.push_back(0);
+    out.push_back(0x2C);
+    PutU16(out, 0);
+    PutU16(out, 0);
+    PutU16(out, width);
+    PutU16(out, height);
+    out.push_back(0); // No local palette, not interlaced.
+    out.push_back(static_cast<uint8_t>(bits)); // LZW minimum code size.
+
+    // The dictionary as a trie: child[code * colors + index] is the code of the string 'code'
+    // followed by 'index', or 0 if that string has no code yet (0 is a literal, never a child).
+    std::vector<uint16_t> child(static_cast<size_t>(kGifMaxCodes) * colors, 0);
+    const int clearCode = 1 << bits;
+    const int endCode = clearCode + 1;
+    int lastCode = endCode;   // Highest code assigned so far.
+    int codeWidth = bits + 1;
+
+    GifBitWriter writer(out);
+    writer.Write(clearCode, codeWidth);
+    int count = width * height;
+    int prefix = count > 0 ? pixels[0] : 0;
+    for (int i = 1; i < count; ++i) {
+        int index = pixels[i];
+        uint16_t& next = child[prefix * colors + index];
+        if (next != 0) {
+            prefix = next; // The string continues; keep reading.
+            continue;
+        }
+        writer.Write(prefix, codeWidth);
+        next = static_cast<uint16_t>(++lastCode);
+        if (lastCode >= (1 << codeWidth)) {
+            ++codeWidth;
+        }
+        if (lastCode == kGifMaxCodes - 1) {
+            // The dictionary is full: start a fresh one, as the decoder will on the clear code.
+            writer.Write(clearCode, codeWidth);
+            std::fill(child.begin(), child.end(), 0);
+            lastCode = endCode;
+            codeWidth = bits + 1;
+        }
+        prefix = index;
+    }
+    writer.Write(prefix, codeWidth);
+    writer.Write(endCode, codeWidth);
+    writer.Finish();
+}
+
+void WriteGifTrailer(std::vector<uint8_t>& out) {
+    out.push_back(0x3B);
+}
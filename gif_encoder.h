@@ -0,0 +1,41 @@
+#ifndef AXE_GAME_GIF_ENCODER_H
+#define AXE_GAME_GIF_ENCODER_H
+
+// Minimal animated GIF (GIF89a) writer for palette images.
+// A GIF is a header with one global palette, then one self-contained block per frame, then a
+// trailer. Each frame block is compressed on its own, so EncodeGifFrame() for different frames
+// can run on different threads at once and the blocks are simply written out in frame order.
+//
+//   std::vector<uint8_t> bytes;
+//   WriteGifHeader(bytes, width, height, palette, 8);
+//   EncodeGifFrame(pixels, width, height, 8, 3, bytes); // 3/100 s, any number of times
+//   WriteGifTrailer(bytes);
+//
+// Pixels are palette indices, one byte each, row by row; every index must be below the palette
+// size given to the header.
+
+#include <cstdint> // Pixel indices and output bytes.
+#include <vector>  // Output buffers.
+
+// The most colors a GIF palette can hold.
+const int kGifMaxColors = 256;
+
+struct GifColor {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+};
+
+// Start a GIF that loops forever. 'colorCount' is rounded up to a power of two (at least 4), and
+// the extra entries are black.
+void WriteGifHeader(std::vector<uint8_t>& out, int width, int height, const GifColor* palette, int colorCount);
+
+// Append one full frame, shown for 'delayCentiseconds' hundredths of a second. 'colorCount' must
+// match the header. Safe to call from several threads at once with different 'out' buffers.
+void EncodeGifFrame(const uint8_t* pixels, int width, int height, int colorCount, int delayCentiseconds,
+                    std::vector<uint8_t>& out);
+
+// End the GIF.
+void WriteGifTrailer(std::vector<uint8_t>& out);
+
+#endif // AXE_GAME_GIF_ENCODER_H
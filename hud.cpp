@@ -0,0 +1,99 @@
+#include "hud.h"
+
+#include "frame_arena.h" // Per-frame storage for the overlay rows.
+#include "profiler.h"    // Frame history shown by the overlay.
+
+#include <cstdio> // snprintf for formatting into the cache's own buffer.
+
+void CachedNumberText::Init(const char* newFormat, int newFontSize) {
+    format = newFormat;
+    fontSize = newFontSize;
+    valid = false;
+}
+
+void CachedNumberText::SetFont(const Font* newFont) {
+    font = newFont;
+    valid = false;
+}
+
+void CachedNumberText::Set(int newValue) {
+    if (valid && newValue == value) {
+        return; // Cache hit: nothing changed since the last frame.
+    }
+    value = newValue;
+    snprintf(text, sizeof(text), format, value);
+    // Same spacing rule as DrawText uses for the built-in font.
+    width = font ? static_cast<int>(MeasureTextEx(*font, text, static_cast<float>(fontSize), fontSize / 10.0f).x)
+                 : MeasureText(text, fontSize);
+    valid = true;
+}
+
+void CachedNumberText::Draw(int x, int y, Color color) const {
+    if (font) {
+        Vector2 position = {static_cast<float>(x), static_cast<float>(y)};
+        DrawTextEx(*font, text, position, static_cast<float>(fontSize), fontSize / 10.0f, color);
+    } else {
+        DrawText(text, x, y, fontSize, color);
+    }
+}
+
+void CachedNumberText::DrawCentered(int centerX, int y, Color color) const {
+    Draw(centerX - width / 2, y, color);
+}
+
+void StaticLabel::Load(const char* text, int fontSize, Color color) {
+    width = MeasureText(text, fontSize);
+    height = fontSize;
+    target = LoadRenderTexture(width, height);
+    BeginTextureMode(target);
+    ClearBackground(BLANK); // Transparent background so the label can sit on anything.
+    DrawText(text, 0, 0, fontSize, color);
+    EndTextureMode();
+}
+
+void StaticLabel::Unload() {
+    UnloadRenderTexture(target);
+    target = RenderTexture2D{};
+}
+
+void StaticLabel::DrawCentered(int centerX, int y) const {
+    // Render textures are stored upside down (OpenGL's origin is bottom-left), so flip the source.
+    Rectangle source = {0.0f, 0.0f, static_cast<float>(width), -static_cast<float>(height)};
+    Vector2 position = {static_cast<float>(centerX - width / 2), static_cast<float>(y)};
+    DrawTextureRec(target.texture, source, position, WHITE);
+}
+
+void DrawProfilerOverlay(FrameProfiler& profiler, FrameArena& arena, int x, int y) {
+    const int fontSize = 10;
+    const int lineHeight = 12;
+    const int histogramBins = 34;   // 0..33 ms; the last bin also holds anything slower.
+    const int histogramHeight = 40;
+    const int width = 250;
+    const int height = (PHASE_COUNT + 3) * lineHeight + histogramHeight + 8;
+
+    DrawRectangle(x, y, width, height, Color{0, 0, 0, 170});
+    DrawText("phase            last    p50    p99 (us)", x + 4, y + 4, fontSize, WHITE);
+
+    // One row per phase and a final row for the whole frame.
+    const FrameProfile& last = profiler.Last();
+    for (int phase = 0; phase <= PHASE_COUNT; ++phase) {
+        uint32_t lastNanos = (phase < PHASE_COUNT) ? last.phaseNanos[phase] : last.frameNanos;
+        DrawText(arena.Format("%-14s %6.0f %6.0f %6.0f", ProfilePhaseName(phase), lastNanos / 1000.0f,
+                              profiler.Percentile(phase, 50.0f) / 1000.0f, profiler.Percentile(phase, 99.0f) / 1000.0f),
+                 x + 4, y + 4 + (phase + 1) * lineHeight, fontSize, phase < PHASE_COUNT ? LIGHTGRAY : YELLOW);
+    }
+
+    // Frame-time histogram: bar height is the share of frames in each 1 ms bin.
+    int bins[histogramBins];
+    profiler.FrameHistogram(bins, histogramBins, 1000000u);
+    int most = 1;
+    for (int bin = 0; bin < histogramBins; ++bin) {
+        most = bins[bin] > most ? bins[bin] : most;
+    }
+    int baseY = y + height - 4;
+    int barWidth = (width - 8) / histogramBins;
+    for (int bin = 0; bin < histogramBins; ++bin) {
+        int barHeight = bins[bin] * histogramHeight / most;
+        DrawRectangle(x + 4 + bin * barWidth, baseY - barHeight, barWidth - 1, barHeight, bin < 17 ? GREEN : ORANGE);
+    }
+}
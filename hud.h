@@ -0,0 +1,65 @@
+#ifndef AXE_GAME_HUD_H
+#define AXE_GAME_HUD_H
+
+// Cached text for the heads-up display and menus.
+// Formatting a string and measuring it with the default font costs far more than drawing it, and the
+// HUD shows the same few strings frame after frame. CachedNumberText only re-formats and re-measures
+// when its number changes; StaticLabel renders constant text once into a texture and then just
+// blits it.
+
+#include "raylib.h"
+
+struct FrameArena;
+struct FrameProfiler;
+
+// A label built from a printf-style format with one integer, like "Score: %i".
+struct CachedNumberText {
+    const char* format = "%i";  // Format string with exactly one %i.
+    int fontSize = 20;          // Size the text is measured and drawn at.
+    const Font* font = nullptr; // Font to draw with; nullptr means raylib's built-in font.
+    int value = 0;              // Number the cached text was built from.
+    bool valid = false;         // False until the first Set() call.
+    char text[64] = {0};        // Formatted text.
+    int width = 0;              // Width of 'text' at 'fontSize' in 'font'.
+
+    // Set the format and font size. Invalidates the cache.
+    void Init(const char* newFormat, int newFontSize);
+
+    // Switch fonts, e.g. once a streamed font is ready. Invalidates the cache.
+    void SetFont(const Font* newFont);
+
+    // Update the number shown. Re-formats and re-measures only if it differs from the cached one.
+    void Set(int newValue);
+
+    // Draw with the top-left corner at (x, y).
+    void Draw(int x, int y, Color color) const;
+
+    // Draw horizontally centered on 'centerX', with the top edge at 'y'.
+    void DrawCentered(int centerX, int y, Color color) const;
+};
+
+// Constant text rendered once into an off-screen texture.
+struct StaticLabel {
+    RenderTexture2D target = {}; // Holds the pre-rendered text.
+    int width = 0;               // Size of the text in pixels.
+    int height = 0;
+
+    // Render 'text' into the texture. Needs an open window (an OpenGL context).
+    void Load(const char* text, int fontSize, Color color);
+
+    // Release the texture.
+    void Unload();
+
+    // True between Load() and Unload(); lets rarely shown labels be loaded on first use.
+    bool Loaded() const { return target.id != 0; }
+
+    // Draw horizontally centered on 'centerX', with the top edge at 'y'.
+    void DrawCentered(int centerX, int y) const;
+};
+
+// Draw the profiler overlay with its top-left corner at (x, y): last, p50 and p99 time per phase in
+// microseconds, plus a histogram of recent frame times in 1 ms bins. The row text is formatted into
+// 'arena', so it must not be reset before the frame is drawn.
+void DrawProfilerOverlay(FrameProfiler& profiler, FrameArena& arena, int x, int y);
+
+#endif // AXE_GAME_HUD_H
@@ -0,0 +1,210 @@
+#include "input.h"
+
+#include "raylib.h" // Keyboard state and GetTime().
+
+#include <chrono> // Sleep durations for the just-in-time pacer.
+#include <thread> // std::this_thread::sleep_for.
+
+#if defined(PLATFORM_WEB)
+#include <emscripten/emscripten.h> // emscripten_set_main_loop_timing.
+#endif
+
+// On desktop raylib runs on GLFW and links it in, and raylib's key codes are GLFW's key codes.
+// Declaring the handful of GLFW entry points needed here avoids depending on GLFW's headers.
+#if defined(PLATFORM_DESKTOP)
+extern "C" {
+typedef struct GLFWwindow GLFWwindow;
+typedef void (*GLFWkeyfun)(GLFWwindow* window, int key, int scancode, int action, int mods);
+GLFWwindow* glfwGetCurrentContext(void);
+GLFWkeyfun glfwSetKeyCallback(GLFWwindow* window, GLFWkeyfun callback);
+void glfwPollEvents(void);
+void glfwWaitEventsTimeout(double timeout);
+double glfwGetTime(void);
+}
+const int kGlfwRelease = 0;
+const int kGlfwPress = 1;
+#endif
+
+// Movement keys and the direction each one holds. Two keys map to every direction.
+struct MovementKey {
+    int key;
+    InputMask direction;
+};
+
+static const MovementKey kMovementKeys[] = {
+    {KEY_D, INPUT_RIGHT}, {KEY_RIGHT, INPUT_RIGHT}, {KEY_A, INPUT_LEFT}, {KEY_LEFT, INPUT_LEFT},
+    {KEY_W, INPUT_UP},    {KEY_UP, INPUT_UP},       {KEY_S, INPUT_DOWN}, {KEY_DOWN, INPUT_DOWN},
+};
+const int kMovementKeyCount = sizeof(kMovementKeys) / sizeof(kMovementKeys[0]);
+
+// Held directions from the current keyboard snapshot.
+static InputMask SnapshotHeld() {
+    InputMask held = INPUT_NONE;
+    for (const MovementKey& entry : kMovementKeys) {
+        if (IsKeyDown(entry.key)) {
+            held |= entry.direction;
+        }
+    }
+    return held;
+}
+
+#if defined(PLATFORM_DESKTOP)
+static InputStage* gInputStage = nullptr;         // Receiver of timestamped events.
+static GLFWkeyfun gRaylibKeyCallback = nullptr;   // Raylib's own handler, still called for every key.
+static uint8_t gHeldKeys = 0;                     // Bit i set while kMovementKeys[i] is down.
+
+static void KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+    if (gRaylibKeyCallback) {
+        gRaylibKeyCallback(window, key, scancode, action, mods); // Keep IsKeyDown/IsKeyPressed working.
+    }
+    if (action != kGlfwPress && action != kGlfwRelease) {
+        return; // Auto-repeat does not change what is held.
+    }
+    for (int i = 0; i < kMovementKeyCount; ++i) {
+        if (kMovementKeys[i].key != key) {
+            continue;
+        }
+        uint8_t bit = static_cast<uint8_t>(1u << i);
+        gHeldKeys = (action == kGlfwPress) ? (gHeldKeys | bit) : (gHeldKeys & ~bit);
+        InputMask held = INPUT_NONE;
+        for (int k = 0; k < kMovementKeyCount; ++k) {
+            if (gHeldKeys & (1u << k)) {
+                held |= kMovementKeys[k].direction;
+            }
+        }
+        gInputStage->Push(glfwGetTime(), held); // Same clock as raylib's GetTime().
+        return;
+    }
+}
+#endif
+
+void InputStage::Install() {
+    head = 0;
+    count = 0;
+    held = polled = SnapshotHeld();
+#if defined(PLATFORM_DESKTOP)
+    if (GLFWwindow* window = glfwGetCurrentContext()) {
+        gInputStage = this;
+        gRaylibKeyCallback = glfwSetKeyCallback(window, KeyCallback);
+        callbackInstalled = true;
+    }
+#endif
+}
+
+FrameKeys InputStage::Poll(bool pollNow) {
+#if defined(PLATFORM_DESKTOP)
+    if (pollNow) {
+        glfwPollEvents(); // Runs the key callbacks now; raylib's own poll happens in EndDrawing().
+    }
+#else
+    (void)pollNow;
+#endif
+    if (!callbackInstalled) {
+        // No event timestamps available: notice changes at poll granularity instead.
+        InputMask now = SnapshotHeld();
+        if (now != polled) {
+            Push(GetTime(), now);
+            polled = now;
+        }
+    }
+    FrameKeys keys;
+    keys.start = IsKeyPressed(KEY_SPACE);
+    keys.restart = IsKeyPressed(KEY_R);
+    keys.pause = IsKeyPressed(KEY_P);
+    keys.toggleProfiler = IsKeyPressed(KEY_F3);
+    keys.dumpProfile = IsKeyPressed(KEY_F4);
+    return keys;
+}
+
+InputMask InputStage::HeldAt(double time) {
+    while (count > 0 && queue[head].time <= time) {
+        held = queue[head].held;
+        head = (head + 1) % kInputQueueSize;
+        --count;
+    }
+    return held;
+}
+
+void InputStage::Push(double time, InputMask newHeld) {
+    if (count == kInputQueueSize) {
+        // Full: apply the oldest change early rather than lose it.
+        held = queue[head].held;
+        head = (head + 1) % kInputQueueSize;
+        --count;
+    }
+    queue[(head + count) % kInputQueueSize] = InputEvent{time, newHeld};
+    ++count;
+}
+
+// Safety margin left before the expected refresh, covering sleep overshoot and timing noise.
+const double kPacerMarginSeconds = 0.0015;
+// Weight of the newest measurement in the smoothed interval and work estimates.
+const double kPacerSmoothing = 0.1;
+
+void LateSamplePacer::WaitForSample() {
+    double deadline = lastPresent + frameInterval - workSeconds - kPacerMarginSeconds;
+    double now = GetTime();
+    if (enabled && now < deadline) {
+        std::this_thread::sleep_for(std::chrono::duration<double>(deadline - now));
+    }
+    sampleTime = GetTime();
+}
+
+void LateSamplePacer::BeginPresent() {
+    double work = GetTime() - sampleTime;
+    workSeconds += (work - workSeconds) * kPacerSmoothing;
+}
+
+void LateSamplePacer::EndPresent() {
+    double now = GetTime();
+    double interval = now - lastPresent;
+    // Ignore stalls (window dragged, breakpoints) so one long frame does not skew the estimate.
+    if (lastPresent > 0.0 && interval < 0.1) {
+        frameInterval += (interval - frameInterval) * kPacerSmoothing;
+    }
+    lastPresent = now;
+}
+
+// Frame rate event-driven states fall back to where the OS event queue cannot be waited on.
+const int kIdleFallbackFps = 10;
+
+void StatePacer::Wait(const PacingRule& rule) {
+#if defined(PLATFORM_WEB)
+    // The browser schedules frames: 0 is requestAnimationFrame, anything else a setTimeout interval.
+    int interval = rule.maxFps > 0 ? 1000 / rule.maxFps : (rule.eventDriven ? 1000 / kIdleFallbackFps : 0);
+    if (interval != webInterval) {
+        if (interval == 0) {
+            emscripten_set_main_loop_timing(EM_TIMING_RAF, 1);
+        } else {
+            emscripten_set_main_loop_timing(EM_TIMING_SETTIMEOUT, interval);
+        }
+        webInterval = interval;
+    }
+#else
+    double now = GetTime();
+    if (lastFrame > 0.0) {
+        int fps = rule.maxFps;
+#if defined(PLATFORM_DESKTOP)
+        if (fps == 0 && rule.eventDriven) {
+            // Key callbacks run inside the wait, so the frame that follows sees the key as pressed.
+            double remaining = lastFrame + rule.idleSeconds - now;
+            if (remaining > 0.0) {
+                glfwWaitEventsTimeout(remaining);
+            }
+        }
+#else
+        if (fps == 0 && rule.eventDriven) {
+            fps = kIdleFallbackFps;
+        }
+#endif
+        if (fps > 0) {
+            double remaining = lastFrame + 1.0 / fps - now;
+            if (remaining > 0.0) {
+                std::this_thread::sleep_for(std::chrono::duration<double>(remaining));
+            }
+        }
+        now = GetTime();
+    }
+    lastFrame = now;
+#endif
+}
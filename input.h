@@ -0,0 +1,99 @@
+#ifndef AXE_GAME_INPUT_H
+#define AXE_GAME_INPUT_H
+
+// Input stage between the keyboard and the simulation.
+// Raylib only exposes the keyboard as a per-frame snapshot, so a key pressed just after a frame was
+// polled used to wait for the next frame and was then applied to every tick of that frame at once.
+// The input stage instead keeps a queue of timestamped changes to the held movement directions.
+// On desktop the timestamps come from GLFW's key callback, i.e. the moment the OS delivered the
+// event; elsewhere they are the time the change was first polled. Each simulation tick then drains
+// the events that happened before the moment the tick represents, so a press lands on the first
+// tick after it actually happened instead of on a frame boundary.
+
+#include "simulation.h" // InputMask.
+
+// Capacity of the pending event queue. Far more key changes than anyone can make in one frame.
+const int kInputQueueSize = 64;
+
+// The held movement directions changed to 'held' at 'time' (seconds on raylib's GetTime() clock).
+struct InputEvent {
+    double time;
+    InputMask held;
+};
+
+// Non-movement keys, sampled once per frame before anything is drawn.
+struct FrameKeys {
+    bool start;          // SPACE: start a game from the menu.
+    bool restart;        // R: restart after game over.
+    bool pause;          // P: pause or resume a game.
+    bool toggleProfiler; // F3: show or hide the profiler overlay.
+    bool dumpProfile;    // F4: write profile.csv.
+};
+
+struct InputStage {
+    InputEvent queue[kInputQueueSize]; // Ring buffer of changes not yet applied to a tick.
+    int head = 0;                      // Oldest pending event.
+    int count = 0;                     // Number of pending events.
+    InputMask held = INPUT_NONE;       // Held directions as of the last applied event.
+    InputMask polled = INPUT_NONE;     // Last snapshot seen by Poll() when there is no key callback.
+    bool callbackInstalled = false;    // True if GLFW delivers timestamped key events directly.
+
+    // Hook into the window's key events, if the platform allows it. Call once after InitWindow().
+    void Install();
+
+    // Collect input at the start of a frame, before anything is drawn. With 'pollNow' the OS event
+    // queue is pumped right here (desktop only) instead of relying on the poll EndDrawing() did,
+    // which is what the just-in-time mode uses to sample as late as possible.
+    FrameKeys Poll(bool pollNow);
+
+    // Apply every event that happened at or before 'time' and return the directions held then.
+    // Called once per simulation tick with the real time the end of that tick corresponds to.
+    InputMask HeldAt(double time);
+
+    // Record a change of the held directions. Public so the key callback can reach it.
+    void Push(double time, InputMask newHeld);
+};
+
+// Optional just-in-time pacing. With VSync on, a frame's sample-simulate-draw work normally starts
+// right after the previous buffer swap and then waits most of a refresh for the next one, so input
+// is nearly a whole frame old when it reaches the screen. The pacer measures the refresh interval
+// and how long the work takes, and sleeps at the start of the frame until just enough time is left
+// to finish before the next swap.
+struct LateSamplePacer {
+    bool enabled = false;
+    double frameInterval = 1.0 / 60.0; // Smoothed time between two presents (seconds).
+    double workSeconds = 0.004;        // Smoothed time from sampling input to starting the present.
+    double lastPresent = 0.0;          // When the previous present returned.
+    double sampleTime = 0.0;           // When this frame sampled its input.
+
+    // Sleep until the latest moment input can be sampled and still make the next refresh.
+    void WaitForSample();
+
+    // Call right before EndDrawing() and right after it returns.
+    void BeginPresent();
+    void EndPresent();
+};
+
+// How often one game state draws frames.
+struct PacingRule {
+    int maxFps;         // Frame rate cap; 0 means none (VSync decides).
+    bool eventDriven;   // Idle: draw a frame only when input arrives or the idle timer fires.
+    double idleSeconds; // The idle timer: the longest an event-driven state goes without a frame.
+};
+
+// Per-state frame pacing. Gameplay wants every refresh, but the menu and the game over screen show
+// text that hardly ever changes, and redrawing them sixty times a second only drains batteries.
+// Wait() runs at the start of each frame and holds it back according to the current state's rule:
+// a capped state sleeps out the rest of its frame interval, and an event-driven one blocks in the OS
+// event queue until a key (or any other window event) arrives or the idle timer fires, which keeps
+// anything slow-changing on screen, like the pending upload count, up to date. The browser cannot be
+// blocked, so the web build asks emscripten for a lower frame rate instead.
+struct StatePacer {
+    double lastFrame = 0.0; // When the previous frame started (GetTime()), or 0 before the first.
+    int webInterval = -1;   // Frame interval last requested from emscripten, in milliseconds.
+
+    // Hold the frame back as 'rule' asks. Never waits before the first frame.
+    void Wait(const PacingRule& rule);
+};
+
+#endif // AXE_GAME_INPUT_H
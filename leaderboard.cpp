@@ -0,0 +1,447 @@
+#include "leaderboard.h"
+
+#include "socket_flags.h" // No SIGPIPE when the server hangs up.
+
+#include <cerrno>  // Telling a socket that would block from one that failed.
+#include <chrono>  // Batch window and retry backoff.
+#include <cstdio>  // Spool file I/O.
+#include <cstring> // memcpy/memcmp for the wire format.
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET SocketHandle;
+#define CLOSE_SOCKET closesocket
+#else
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef int SocketHandle;
+const SocketHandle INVALID_SOCKET = -1;
+#define CLOSE_SOCKET close
+#endif
+
+// How long the worker waits after a submission for more to join the same upload.
+const std::chrono::milliseconds kBatchWindow(2000);
+// Most replays packed into one upload.
+const size_t kMaxBatchEntries = 32;
+// Retry backoff after a failed upload: doubles from the minimum up to the maximum.
+const std::chrono::seconds kMinRetryDelay(1);
+const std::chrono::seconds kMaxRetryDelay(60);
+// Longest wait for a connect, send or receive to make progress, so a dead server cannot stall the
+// worker forever.
+const int kSocketTimeoutSeconds = 5;
+// Socket waits are split into slices this long, checking for Stop() in between.
+const int kCancelCheckMillis = 50;
+
+static void PutU16(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+static void PutU32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+static uint32_t GetU32(const uint8_t* data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+// Compressed stream: a sequence of tokens.
+//   0x00-0x7F  literal run: (token + 1) bytes follow and are copied as-is.
+//   0x80-0xFF  match: copy (token - 0x80 + kMinMatch) bytes starting u16 'offset' bytes back.
+const size_t kMinMatch = 4;
+const size_t kMaxMatch = 0x7F + kMinMatch;
+const size_t kMaxLiteralRun = 0x80;
+const size_t kMaxOffset = 0xFFFF;
+const int kHashBits = 12;
+
+static uint32_t HashFour(const uint8_t* data) {
+    uint32_t value;
+    memcpy(&value, data, 4);
+    return (value * 2654435761u) >> (32 - kHashBits);
+}
+
+std::vector<uint8_t> LeaderboardCompress(const uint8_t* data, size_t size) {
+    std::vector<uint8_t> out;
+    out.reserve(size + size / kMaxLiteralRun + 1);
+    std::vector<size_t> table(static_cast<size_t>(1) << kHashBits, static_cast<size_t>(-1));
+
+    size_t literalStart = 0;
+    auto flushLiterals = [&](size_t end) {
+        while (literalStart < end) {
+            size_t run = end - literalStart < kMaxLiteralRun ? end - literalStart : kMaxLiteralRun;
+            out.push_back(static_cast<uint8_t>(run - 1));
+            out.insert(out.end(), data + literalStart, data + literalStart + run);
+            literalStart += run;
+        }
+    };
+
+    size_t i = 0;
+    while (i + kMinMatch <= size) {
+        // Greedy: take whatever the last position with the same 4-byte hash offers.
+        uint32_t hash = HashFour(data + i);
+        size_t candidate = table[hash];
+        table[hash] = i;
+        if (candidate != static_cast<size_t>(-1) && i - candidate <= kMaxOffset &&
+            memcmp(data + candidate, data + i, kMinMatch) == 0) {
+            size_t length = kMinMatch;
+            while (i + length < size && length < kMaxMatch && data[candidate + length] == data[i + length]) {
+                ++length;
+            }
+            flushLiterals(i);
+            size_t offset = i - candidate;
+            out.push_back(static_cast<uint8_t>(0x80 + (length - kMinMatch)));
+            PutU16(out, static_cast<uint16_t>(offset));
+            i += length;
+            literalStart = i;
+        } else {
+            ++i;
+        }
+    }
+    flushLiterals(size);
+    return out;
+}
+
+bool LeaderboardDecompress(const uint8_t* data, size_t size, size_t rawSize, std::vector<uint8_t>& out) {
+    out.clear();
+    // The best case is all matches: 3 bytes of input for kMaxMatch bytes of output.
+    if (rawSize > kMaxLeaderboardBatchBytes || rawSize > size / 3 * kMaxMatch + size % 3) {
+        return false;
+    }
+    out.reserve(rawSize);
+    size_t i = 0;
+    while (i < size) {
+        uint8_t token = data[i++];
+        if (token < 0x80) {
+            size_t run = token + 1u;
+            if (i + run > size || out.size() + run > rawSize) {
+                return false;
+            }
+            out.insert(out.end(), data + i, data + i + run);
+            i += run;
+        } else {
+            size_t length = token - 0x80u + kMinMatch;
+            if (i + 2 > size) {
+                return false;
+            }
+            size_t offset = data[i] | (data[i + 1] << 8);
+            i += 2;
+            if (offset == 0 || offset > out.size() || out.size() + length > rawSize) {
+                return false;
+            }
+            size_t from = out.size() - offset;
+            for (size_t k = 0; k < length; ++k) {
+                out.push_back(out[from + k]); // Byte by byte: a match may overlap its own output.
+            }
+        }
+    }
+    return out.size() == rawSize;
+}
+
+// Pack replays into one compressed upload body.
+static std::vector<uint8_t> BuildUpload(const std::vector<std::vector<uint8_t>>& replays) {
+    std::vector<uint8_t> batch;
+    batch.insert(batch.end(), {'A', 'X', 'L', 'B'});
+    PutU16(batch, kLeaderboardVersion);
+    PutU16(batch, static_cast<uint16_t>(replays.size()));
+    for (const std::vector<uint8_t>& replay : replays) {
+        PutU32(batch, static_cast<uint32_t>(replay.size()));
+        batch.insert(batch.end(), replay.begin(), replay.end());
+    }
+
+    std::vector<uint8_t> compressed = LeaderboardCompress(batch.data(), batch.size());
+    std::vector<uint8_t> body;
+    body.reserve(8 + compressed.size());
+    body.insert(body.end(), {'A', 'X', 'L', 'Z'});
+    PutU32(body, static_cast<uint32_t>(batch.size()));
+    body.insert(body.end(), compressed.begin(), compressed.end());
+    return body;
+}
+
+bool LeaderboardClient::Start(const char* url, const char* spool) {
+    Stop();
+    std::string address = url;
+    size_t slash = address.find('/');
+    path = slash == std::string::npos ? "/" : address.substr(slash);
+    address = address.substr(0, slash);
+    size_t colon = address.rfind(':');
+    if (colon == std::string::npos || colon == 0 || colon + 1 == address.size()) {
+        return false;
+    }
+    host = address.substr(0, colon);
+    port = address.substr(colon + 1);
+    spoolPath = spool;
+
+#if defined(_WIN32)
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+        return false;
+    }
+#endif
+    LoadSpool();
+    stopping = false;
+    worker = std::thread(&LeaderboardClient::RunWorker, this);
+    return true;
+}
+
+void LeaderboardClient::Stop() {
+    if (!worker.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cancelling = true; // Abandon an upload in progress; its batch stays spooled.
+    wake.notify_one();
+    worker.join();
+    cancelling = false;
+#if defined(_WIN32)
+    WSACleanup();
+#endif
+}
+
+void LeaderboardClient::Submit(std::vector<uint8_t> replay) {
+    if (!worker.joinable()) {
+        return;
+    }
+    ++pendingCount; // Counted before the worker can see it, so Pending() never dips below zero.
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        incoming.push_back(std::move(replay));
+    }
+    wake.notify_one();
+}
+
+void LeaderboardClient::RunWorker() {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point nextAttempt = Clock::now(); // Spooled batches are tried right away.
+    std::chrono::seconds retryDelay = kMinRetryDelay;
+    std::vector<std::vector<uint8_t>> taken;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        // Sleep until there is something new, a retry is due, or we are asked to stop.
+        auto hasWork = [this] { return stopping || !incoming.empty(); };
+        if (retry.empty()) {
+            wake.wait(lock, hasWork);
+        } else {
+            wake.wait_until(lock, nextAttempt, hasWork);
+        }
+        // Give games finished in quick succession a moment to join the same upload.
+        if (!stopping && !incoming.empty()) {
+            wake.wait_for(lock, kBatchWindow, [this] { return stopping || incoming.size() >= kMaxBatchEntries; });
+        }
+        taken.swap(incoming);
+        bool stop = stopping;
+        lock.unlock();
+
+        for (size_t first = 0; first < taken.size(); first += kMaxBatchEntries) {
+            size_t last = first + kMaxBatchEntries < taken.size() ? first + kMaxBatchEntries : taken.size();
+            std::vector<std::vector<uint8_t>> entries(taken.begin() + first, taken.begin() + last);
+            retry.push_back(Batch{BuildUpload(entries), static_cast<int>(entries.size())});
+        }
+        if (!taken.empty()) {
+            taken.clear();
+            SaveSpool(); // Once spooled, a submission survives a crash or a quit.
+        }
+        if (stop) {
+            return; // Undelivered batches stay in the spool for the next run.
+        }
+
+        if (Clock::now() >= nextAttempt) {
+            while (!retry.empty()) {
+                if (!Send(retry.front().body)) {
+                    offline = true;
+                    nextAttempt = Clock::now() + retryDelay;
+                    retryDelay = retryDelay * 2 < kMaxRetryDelay ? retryDelay * 2 : kMaxRetryDelay;
+                    break;
+                }
+                pendingCount -= retry.front().entries;
+                retry.erase(retry.begin());
+                SaveSpool();
+                offline = false;
+                retryDelay = kMinRetryDelay;
+            }
+        }
+        lock.lock();
+    }
+}
+
+static void SetNonBlocking(SocketHandle sock) {
+#if defined(_WIN32)
+    u_long on = 1;
+    ioctlsocket(sock, FIONBIO, &on);
+#else
+    fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+#endif
+}
+
+// True if the last socket call on this thread failed only because it could not finish at once.
+static bool WouldBlock() {
+#if defined(_WIN32)
+    int error = WSAGetLastError();
+    return error == WSAEWOULDBLOCK || error == WSAEINPROGRESS;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINPROGRESS || errno == EINTR;
+#endif
+}
+
+// Wait until 'sock' can be written to (or read from), for at most kSocketTimeoutSeconds. Returns
+// false on timeout, on a socket error, or as soon as 'cancel' is set.
+static bool WaitForSocket(SocketHandle sock, bool write, const std::atomic<bool>& cancel) {
+    for (int waited = 0; waited < kSocketTimeoutSeconds * 1000; waited += kCancelCheckMillis) {
+        if (cancel.load()) {
+            return false;
+        }
+#if defined(_WIN32)
+        // select() has no descriptor limit on Windows (fd_set is a list of handles), and a failed
+        // connect shows up in the exception set.
+        fd_set readySet;
+        FD_ZERO(&readySet);
+        FD_SET(sock, &readySet);
+        fd_set failed = readySet;
+        timeval slice = {0, kCancelCheckMillis * 1000};
+        int ready = select(0, write ? nullptr : &readySet, write ? &readySet : nullptr, &failed, &slice);
+#else
+        pollfd entry = {sock, static_cast<short>(write ? POLLOUT : POLLIN), 0};
+        int ready = poll(&entry, 1, kCancelCheckMillis);
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+#endif
+        if (ready != 0) {
+            return ready > 0; // Ready, or failed: the next socket call reports which.
+        }
+    }
+    return false;
+}
+
+bool LeaderboardClient::Send(const std::vector<uint8_t>& body) {
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0) {
+        return false;
+    }
+    SocketHandle sock = INVALID_SOCKET;
+    for (addrinfo* address = addresses; address; address = address->ai_next) {
+        sock = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (sock == INVALID_SOCKET) {
+            continue;
+        }
+        // Non-blocking, so every wait below can give up as soon as Stop() is called.
+        SetNonBlocking(sock);
+        SuppressSigPipe(static_cast<intptr_t>(sock));
+        bool connected = connect(sock, address->ai_addr, static_cast<int>(address->ai_addrlen)) == 0;
+        if (!connected && WouldBlock() && WaitForSocket(sock, true, cancelling)) {
+            int error = 0;
+            socklen_t length = sizeof(error);
+            connected = getsockopt(sock, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &length) == 0 &&
+                        error == 0;
+        }
+        if (connected) {
+            break;
+        }
+        CLOSE_SOCKET(sock);
+        sock = INVALID_SOCKET;
+    }
+    freeaddrinfo(addresses);
+    if (sock == INVALID_SOCKET) {
+        return false;
+    }
+
+    char header[512];
+    int headerSize = snprintf(header, sizeof(header),
+                              "POST %s HTTP/1.1\r\nHost: %s:%s\r\nContent-Type: application/x-axe-leaderboard\r\n"
+                              "Content-Length: %u\r\nConnection: close\r\n\r\n",
+                              path.c_str(), host.c_str(), port.c_str(), static_cast<unsigned>(body.size()));
+    std::vector<uint8_t> request(header, header + headerSize);
+    request.insert(request.end(), body.begin(), body.end());
+
+    bool sent = true;
+    for (size_t offset = 0; sent && offset < request.size();) {
+        int chunk = static_cast<int>(send(sock, reinterpret_cast<const char*>(request.data() + offset),
+                                          static_cast<int>(request.size() - offset), kSocketSendFlags));
+        if (chunk > 0) {
+            offset += static_cast<size_t>(chunk);
+        } else {
+            sent = chunk < 0 && WouldBlock() && WaitForSocket(sock, true, cancelling);
+        }
+    }
+
+    // Only the status line matters: any 2xx means the server has the batch. The rest of the
+    // response is read and dropped so the connection closes cleanly.
+    char status[16] = {};
+    char discard[256];
+    size_t received = 0;
+    while (sent) {
+        bool inStatus = received < sizeof(status) - 1;
+        char* target = inStatus ? status + received : discard;
+        int room = inStatus ? static_cast<int>(sizeof(status) - 1 - received) : static_cast<int>(sizeof(discard));
+        int chunk = static_cast<int>(recv(sock, target, room, 0));
+        if (chunk < 0 && WouldBlock() && WaitForSocket(sock, false, cancelling)) {
+            continue;
+        }
+        if (chunk <= 0) {
+            break;
+        }
+        received += inStatus ? static_cast<size_t>(chunk) : 0;
+    }
+    CLOSE_SOCKET(sock);
+    return sent && received >= 12 && memcmp(status, "HTTP/1.", 7) == 0 && status[9] == '2';
+}
+
+void LeaderboardClient::SaveSpool() const {
+    if (retry.empty()) {
+        remove(spoolPath.c_str());
+        return;
+    }
+    // Write a new file and rename it over the old one, so a crash mid-write keeps the old spool.
+    std::string temporary = spoolPath + ".tmp";
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if (!file) {
+        return;
+    }
+    bool ok = true;
+    for (const Batch& batch : retry) {
+        std::vector<uint8_t> prefix;
+        PutU32(prefix, static_cast<uint32_t>(batch.entries));
+        PutU32(prefix, static_cast<uint32_t>(batch.body.size()));
+        ok = ok && fwrite(prefix.data(), 1, prefix.size(), file) == prefix.size() &&
+             fwrite(batch.body.data(), 1, batch.body.size(), file) == batch.body.size();
+    }
+    ok = fclose(file) == 0 && ok;
+    if (ok) {
+#if defined(_WIN32)
+        remove(spoolPath.c_str()); // rename() does not replace an existing file on Windows.
+#endif
+        rename(temporary.c_str(), spoolPath.c_str());
+    }
+}
+
+void LeaderboardClient::LoadSpool() {
+    retry.clear();
+    FILE* file = fopen(spoolPath.c_str(), "rb");
+    if (!file) {
+        return;
+    }
+    uint8_t prefix[8];
+    while (fread(prefix, 1, sizeof(prefix), file) == sizeof(prefix)) {
+        Batch batch;
+        batch.entries = static_cast<int>(GetU32(prefix));
+        batch.body.resize(GetU32(prefix + 4));
+        if (fread(batch.body.data(), 1, batch.body.size(), file) != batch.body.size()) {
+            break; // Truncated tail; keep what came before it.
+        }
+        pendingCount += batch.entries;
+        retry.push_back(std::move(batch));
+    }
+    fclose(file);
+}
@@ -0,0 +1,92 @@
+#ifndef AXE_GAME_LEADERBOARD_H
+#define AXE_GAME_LEADERBOARD_H
+
+// Remote leaderboard submission.
+// Finished games are handed to a background network worker as encoded replays (the replay carries
+// the score, seed, axe count and tuning hash, so the server can re-simulate and verify it). The
+// worker waits briefly so games finished close together share one upload, packs them into a batch,
+// compresses it and POSTs it over plain HTTP/1.1. A batch that cannot be delivered is kept and
+// retried with exponential backoff, and it is spooled to disk so submissions made offline survive a
+// restart. Submit() only moves the replay into a queue; the render loop never touches the network.
+//
+// Upload body (all integers little-endian):
+//   "AXLZ"  magic
+//   u32     uncompressed batch size
+//   ...     LeaderboardCompress() of the batch:
+//             "AXLB" magic, u16 version (kLeaderboardVersion), u16 entry count,
+//             then per entry: u32 size, replay bytes (see replay.h)
+//
+// Spool file: consecutive (u32 entry count, u32 size, upload body) records, rewritten whenever the
+// retry queue changes.
+
+#include <atomic>             // Status counters read by the render loop.
+#include <condition_variable> // Waking the worker.
+#include <cstddef>            // size_t for buffer sizes.
+#include <cstdint>            // Fixed-width wire fields.
+#include <mutex>              // Guards the queues shared with the worker.
+#include <string>             // Host, path and spool file names.
+#include <thread>             // Network worker.
+#include <vector>             // Payload buffers.
+
+const uint16_t kLeaderboardVersion = 1;
+// Largest uncompressed batch LeaderboardDecompress() accepts. Real batches hold at most a few dozen
+// run-length encoded replays, a tiny fraction of this.
+const size_t kMaxLeaderboardBatchBytes = 16 * 1024 * 1024;
+
+// Small LZ77 compressor for upload batches (byte-oriented, 64 KiB window, no entropy coding).
+// Batches repeat the same headers and similar run patterns, which it removes cheaply.
+std::vector<uint8_t> LeaderboardCompress(const uint8_t* data, size_t size);
+// Inverse of LeaderboardCompress. Returns false if 'data' is malformed or does not expand to 'rawSize'.
+// 'rawSize' comes from the untrusted upload header, so it is checked against kMaxLeaderboardBatchBytes
+// and against the most 'size' bytes can expand to before anything is allocated.
+bool LeaderboardDecompress(const uint8_t* data, size_t size, size_t rawSize, std::vector<uint8_t>& out);
+
+struct LeaderboardClient {
+    // Start the worker for "host:port/path" ("/" if no path is given). Batches left over from an
+    // earlier run are loaded from 'spoolPath' and retried first. Returns false if 'url' is malformed.
+    bool Start(const char* url, const char* spoolPath);
+
+    // Stop the worker. An upload in progress is abandoned within a fraction of a second; only an
+    // address lookup already under way (getaddrinfo cannot be interrupted) is waited for. Anything
+    // not yet delivered stays in the spool file for the next run.
+    void Stop();
+
+    ~LeaderboardClient() { Stop(); }
+
+    // Queue an encoded replay for upload. Never blocks on the network.
+    void Submit(std::vector<uint8_t> replay);
+
+    // Replays queued or spooled but not yet accepted by the server. Cheap; safe to call every frame.
+    int Pending() const { return pendingCount.load(); }
+
+    // True once an upload attempt has failed and no later attempt has succeeded.
+    bool Offline() const { return offline.load(); }
+
+    // Internal state.
+    std::string host;
+    std::string port;
+    std::string path;
+    std::string spoolPath;
+
+    struct Batch {
+        std::vector<uint8_t> body; // Upload body, ready to send.
+        int entries;               // Replays inside it.
+    };
+
+    std::thread worker;
+    std::mutex mutex;                          // Guards 'incoming' and 'stopping'.
+    std::condition_variable wake;              // Signalled on Submit() and Stop().
+    std::vector<std::vector<uint8_t>> incoming; // Replays submitted since the worker last looked.
+    bool stopping = false;
+    std::vector<Batch> retry;                  // Batches waiting to be (re)sent; worker only.
+    std::atomic<int> pendingCount{0};
+    std::atomic<bool> offline{false};
+    std::atomic<bool> cancelling{false};       // Set by Stop(): give up on the network now.
+
+    void RunWorker();
+    bool Send(const std::vector<uint8_t>& body);
+    void SaveSpool() const;
+    void LoadSpool();
+};
+
+#endif // AXE_GAME_LEADERBOARD_H
@@ -0,0 +1,135 @@
+#include "obstacles.h"
+
+#include "simulation.h" // SweptCircleHitsSquare.
+
+#include <cmath> // sqrtf and fabsf. No trigonometry: results must not depend on the C library's sin/cos.
+
+Entity SpawnSpinningAxe(EcsRegistry& obstacles, float x, float y, float speedX, float speedY, float length,
+                        float radiansPerSecond) {
+    return obstacles.Create(Position{x, y}, PrevPosition{x, y}, Velocity{speedX, speedY}, Extent{length},
+                            Orientation{1.0f, 0.0f}, Spin{radiansPerSecond});
+}
+
+Entity SpawnHomingAxe(EcsRegistry& obstacles, float x, float y, float length, float speed, float turnRate) {
+    // Starts heading straight down; steering takes over on the first step.
+    return obstacles.Create(Position{x, y}, PrevPosition{x, y}, Velocity{0.0f, speed}, Extent{length},
+                            Homing{speed, turnRate});
+}
+
+void SteerHomingObstacles(EcsRegistry& obstacles, float targetX, float targetY, float deltaTime) {
+    obstacles.Each<Position, Velocity, Extent, Homing>(
+        [&](Position& position, Velocity& velocity, Extent& extent, Homing& homing) {
+            float dx = targetX - (position.x + extent.length / 2.0f);
+            float dy = targetY - (position.y + extent.length / 2.0f);
+            float distance = sqrtf(dx * dx + dy * dy);
+            if (distance <= 0.0f) {
+                return;
+            }
+            // Blend the velocity towards the full-speed heading at the target, then restore the speed.
+            float blend = homing.turnRate * deltaTime;
+            blend = blend > 1.0f ? 1.0f : blend;
+            float vx = velocity.x + (dx / distance * homing.speed - velocity.x) * blend;
+            float vy = velocity.y + (dy / distance * homing.speed - velocity.y) * blend;
+            float speed = sqrtf(vx * vx + vy * vy);
+            if (speed > 0.0f) {
+                velocity.x = vx / speed * homing.speed;
+                velocity.y = vy / speed * homing.speed;
+            }
+        });
+}
+
+int MoveObstacles(EcsRegistry& obstacles, float screenWidth, float screenHeight, float deltaTime) {
+    int bounces = 0;
+    obstacles.Each<Position, PrevPosition, Velocity, Extent>(
+        [&](Position& position, PrevPosition& previous, Velocity& velocity, Extent& extent) {
+            previous.x = position.x;
+            previous.y = position.y;
+            position.x += velocity.x * deltaTime;
+            position.y += velocity.y * deltaTime;
+            bool bounceX = position.x + extent.length > screenWidth || position.x < 0;
+            bool bounceY = position.y + extent.length > screenHeight || position.y < 0;
+            if (bounceX) {
+                velocity.x = -velocity.x;
+            }
+            if (bounceY) {
+                velocity.y = -velocity.y;
+            }
+            bounces += bounceX || bounceY;
+        });
+    return bounces;
+}
+
+void SpinObstacles(EcsRegistry& obstacles, float deltaTime) {
+    obstacles.Each<Orientation, Spin>([&](Orientation& orientation, Spin& spin) {
+        // Rotate by the Cayley transform of half the step angle: an exact rotation by almost exactly
+        // that angle, using only arithmetic, so every platform spins identically.
+        float t = spin.radiansPerSecond * deltaTime * 0.5f;
+        float scale = 1.0f / (1.0f + t * t);
+        float stepCos = (1.0f - t * t) * scale;
+        float stepSin = 2.0f * t * scale;
+        float c = orientation.cos * stepCos - orientation.sin * stepSin;
+        float s = orientation.sin * stepCos + orientation.cos * stepSin;
+        // Renormalize so rounding errors cannot slowly grow or shrink the square.
+        float length = sqrtf(c * c + s * s);
+        orientation.cos = c / length;
+        orientation.sin = s / length;
+    });
+}
+
+void RampObstacles(EcsRegistry& obstacles, float factor, float maxSpeedX, float maxSpeedY) {
+    // Homing obstacles get their speed from Homing, so only the free-flying ones ramp by velocity.
+    obstacles.Each<Velocity>(
+        [&](Velocity& velocity) {
+            if (fabsf(velocity.x) < maxSpeedX) {
+                velocity.x *= factor;
+            }
+            if (fabsf(velocity.y) < maxSpeedY) {
+                velocity.y *= factor;
+            }
+        },
+        MaskOfTypes<Homing>());
+    obstacles.Each<Homing>([&](Homing& homing) {
+        if (homing.speed < maxSpeedX) {
+            homing.speed *= factor;
+        }
+    });
+}
+
+Entity FindObstacleCollision(EcsRegistry& obstacles, float prevCenterX, float prevCenterY, float centerX,
+                             float centerY, float radius) {
+    Entity hit;
+    bool found = false;
+
+    // Axis-aligned squares: the same swept test as the classic axes.
+    obstacles.EachEntity<Position, PrevPosition, Extent>(
+        [&](Entity entity, Position& position, PrevPosition& previous, Extent& extent) {
+            if (!found && SweptCircleHitsSquare(prevCenterX, prevCenterY, centerX, centerY, radius, previous.x,
+                                                previous.y, position.x, position.y, extent.length)) {
+                hit = entity;
+                found = true;
+            }
+        },
+        MaskOfTypes<Orientation>());
+
+    // Rotated squares: express the circle's motion relative to the square's center and rotate it into
+    // the square's frame, where the square is axis-aligned and sits still at [0, length]^2.
+    obstacles.EachEntity<Position, PrevPosition, Extent, Orientation>(
+        [&](Entity entity, Position& position, PrevPosition& previous, Extent& extent, Orientation& orientation) {
+            if (found) {
+                return;
+            }
+            float half = extent.length / 2.0f;
+            float x0 = prevCenterX - (previous.x + half);
+            float y0 = prevCenterY - (previous.y + half);
+            float x1 = centerX - (position.x + half);
+            float y1 = centerY - (position.y + half);
+            float c = orientation.cos;
+            float s = orientation.sin;
+            if (SweptCircleHitsSquare(c * x0 + s * y0 + half, -s * x0 + c * y0 + half, c * x1 + s * y1 + half,
+                                      -s * x1 + c * y1 + half, radius, 0.0f, 0.0f, 0.0f, 0.0f, extent.length)) {
+                hit = entity;
+                found = true;
+            }
+        });
+    return hit;
+}
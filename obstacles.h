@@ -0,0 +1,79 @@
+#ifndef AXE_GAME_OBSTACLES_H
+#define AXE_GAME_OBSTACLES_H
+
+// Obstacle types beyond the classic bouncing axe, built from ECS components (see ecs.h).
+// The classic axes stay in AxePool, whose structure-of-arrays layout feeds the SIMD kernels and the
+// broad-phase grid, and the player stays a plain Player; moving them into the registry was left out
+// on purpose, so anything that visits every obstacle loops over both stores. Every other kind of obstacle is an entity in World::obstacles made of the
+// components below, and the systems in this file advance all of them by component, not by type:
+//
+//   spinning axe = Position + PrevPosition + Velocity + Extent + Orientation + Spin
+//   homing axe   = Position + PrevPosition + Velocity + Extent + Homing
+//
+// so a new obstacle type is usually a new combination of existing components plus, at most, one
+// small system for the component that makes it different.
+
+#include "ecs.h"
+
+struct Position {     // Top-left corner of the obstacle's (unrotated) square.
+    float x;
+    float y;
+};
+struct PrevPosition { // Position before the last step, for interpolation and swept collision.
+    float x;
+    float y;
+};
+struct Velocity {     // Pixels per second.
+    float x;
+    float y;
+};
+struct Extent {       // Side length of the square.
+    float length;
+};
+struct Orientation {  // Rotation about the square's center, as a unit vector (cos, sin).
+    float cos;
+    float sin;
+};
+struct Spin {         // Angular speed in radians per second; positive is clockwise on screen.
+    float radiansPerSecond;
+};
+struct Homing {       // Steers towards the player at a constant speed.
+    float speed;      // Pixels per second.
+    float turnRate;   // How quickly the velocity swings towards the player (per second).
+};
+
+ECS_COMPONENT(Position, 0);
+ECS_COMPONENT(PrevPosition, 1);
+ECS_COMPONENT(Velocity, 2);
+ECS_COMPONENT(Extent, 3);
+ECS_COMPONENT(Orientation, 4);
+ECS_COMPONENT(Spin, 5);
+ECS_COMPONENT(Homing, 6);
+
+// Spawn helpers for the obstacle types above.
+Entity SpawnSpinningAxe(EcsRegistry& obstacles, float x, float y, float speedX, float speedY, float length,
+                        float radiansPerSecond);
+Entity SpawnHomingAxe(EcsRegistry& obstacles, float x, float y, float length, float speed, float turnRate);
+
+// Swing every homing obstacle's velocity towards the point (targetX, targetY), keeping its speed.
+void SteerHomingObstacles(EcsRegistry& obstacles, float targetX, float targetY, float deltaTime);
+
+// Move every obstacle with a velocity by 'deltaTime' seconds and bounce it off the edges of the
+// playfield, with exactly the rules of Axe::Move. Records the previous positions first. Returns how
+// many obstacles bounced.
+int MoveObstacles(EcsRegistry& obstacles, float screenWidth, float screenHeight, float deltaTime);
+
+// Rotate every spinning obstacle by its angular speed over 'deltaTime' seconds.
+void SpinObstacles(EcsRegistry& obstacles, float deltaTime);
+
+// Apply one difficulty ramp step: speeds are multiplied by 'factor' unless already at the caps.
+// Homing speeds ramp too and are capped by 'maxSpeedX'.
+void RampObstacles(EcsRegistry& obstacles, float factor, float maxSpeedX, float maxSpeedY);
+
+// Return the first obstacle the circle touched during the last step, or an invalid Entity.
+// The circle moved from (prevCenterX, prevCenterY) to (centerX, centerY). Rotated squares are tested
+// in their own frame at their current orientation.
+Entity FindObstacleCollision(EcsRegistry& obstacles, float prevCenterX, float prevCenterY, float centerX,
+                             float centerY, float radius);
+
+#endif // AXE_GAME_OBSTACLES_H
@@ -0,0 +1,88 @@
+#include "profiler.h"
+
+#include <algorithm> // std::nth_element for percentiles.
+#include <chrono>    // steady_clock as the time source.
+#include <cstdio>    // CSV output.
+
+static const char* const kPhaseNames[PHASE_COUNT] = {
+    "input", "player_move", "axe_move", "collision", "hud", "draw", "present",
+};
+
+const char* ProfilePhaseName(int phase) {
+    return (phase >= 0 && phase < PHASE_COUNT) ? kPhaseNames[phase] : "frame";
+}
+
+uint64_t ProfileNow() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void FrameProfiler::BeginFrame() {
+    current = FrameProfile{};
+    frameStart = enabled ? ProfileNow() : 0;
+}
+
+void FrameProfiler::EndFrame() {
+    if (!enabled || frameStart == 0) {
+        return; // Profiling was switched on mid-frame; start cleanly with the next one.
+    }
+    current.frameNanos = static_cast<uint32_t>(ProfileNow() - frameStart);
+    history[head] = current;
+    head = (head + 1) % kProfileHistory;
+    if (count < kProfileHistory) {
+        ++count;
+    }
+}
+
+void FrameProfiler::Add(int phase, uint64_t nanos) {
+    current.phaseNanos[phase] += static_cast<uint32_t>(nanos);
+}
+
+const FrameProfile& FrameProfiler::Last() const {
+    return history[(head + kProfileHistory - 1) % kProfileHistory];
+}
+
+uint32_t FrameProfiler::Percentile(int phase, float p) {
+    if (count == 0) {
+        return 0;
+    }
+    for (int i = 0; i < count; ++i) {
+        scratch[i] = (phase < PHASE_COUNT) ? history[i].phaseNanos[phase] : history[i].frameNanos;
+    }
+    int rank = static_cast<int>(p / 100.0f * (count - 1) + 0.5f);
+    std::nth_element(scratch, scratch + rank, scratch + count);
+    return scratch[rank];
+}
+
+void FrameProfiler::FrameHistogram(int* bins, int binCount, uint32_t binNanos) const {
+    for (int bin = 0; bin < binCount; ++bin) {
+        bins[bin] = 0;
+    }
+    for (int i = 0; i < count; ++i) {
+        int bin = static_cast<int>(history[i].frameNanos / binNanos);
+        bins[bin < binCount ? bin : binCount - 1] += 1;
+    }
+}
+
+bool FrameProfiler::DumpCsv(const char* path) const {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+    fprintf(file, "frame_us");
+    for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+        fprintf(file, ",%s_us", kPhaseNames[phase]);
+    }
+    fprintf(file, "\n");
+
+    int oldest = (count < kProfileHistory) ? 0 : head;
+    for (int i = 0; i < count; ++i) {
+        const FrameProfile& frame = history[(oldest + i) % kProfileHistory];
+        fprintf(file, "%.1f", frame.frameNanos / 1000.0);
+        for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+            fprintf(file, ",%.1f", frame.phaseNanos[phase] / 1000.0);
+        }
+        fprintf(file, "\n");
+    }
+    return fclose(file) == 0;
+}
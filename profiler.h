@@ -0,0 +1,86 @@
+#ifndef AXE_GAME_PROFILER_H
+#define AXE_GAME_PROFILER_H
+
+// Built-in frame profiler.
+// Each frame is split into a few named phases. ProfileScope measures a phase with the steady clock
+// and adds it to the current frame; at the end of the frame the totals go into a fixed-size ring
+// buffer. All storage is inside FrameProfiler itself, so profiling never allocates, and a disabled
+// profiler costs one branch per scope. This header does not depend on raylib, so the simulation
+// core can report its own phases.
+
+#include <cstdint> // Fixed-width nanosecond counters.
+
+enum ProfilePhase {
+    PHASE_INPUT,       // Reading the keyboard.
+    PHASE_PLAYER_MOVE, // Player::Move inside World::Step.
+    PHASE_AXE_MOVE,    // AxePool::Move plus the grid update.
+    PHASE_COLLISION,   // Broad and narrow phase collision.
+    PHASE_HUD,         // Formatting and drawing text.
+    PHASE_DRAW,        // Submitting the player and axes to the renderer.
+    PHASE_PRESENT,     // EndDrawing: buffer swap, VSync wait and event polling.
+    PHASE_COUNT
+};
+
+// Short display name of a phase, also used as the CSV column header.
+const char* ProfilePhaseName(int phase);
+
+// Current steady-clock time in nanoseconds.
+uint64_t ProfileNow();
+
+// Frames kept in the ring buffer (about 8 seconds at 60 FPS).
+const int kProfileHistory = 512;
+
+// Time spent in each phase during one frame, plus the whole frame.
+struct FrameProfile {
+    uint32_t phaseNanos[PHASE_COUNT];
+    uint32_t frameNanos;
+};
+
+struct FrameProfiler {
+    bool enabled = false;              // Nothing is measured while false.
+    FrameProfile history[kProfileHistory] = {};
+    int head = 0;                      // Index the next finished frame is written to.
+    int count = 0;                     // Number of valid frames in 'history'.
+    FrameProfile current = {};         // Frame being measured.
+    uint64_t frameStart = 0;           // ProfileNow() at BeginFrame().
+    uint32_t scratch[kProfileHistory]; // Work space for percentiles, so queries never allocate.
+
+    // Frame boundaries. Call BeginFrame() at the top of the main loop and EndFrame() after present.
+    void BeginFrame();
+    void EndFrame();
+
+    // Add 'nanos' to 'phase' in the current frame. Phases may be added to many times per frame.
+    void Add(int phase, uint64_t nanos);
+
+    // The most recently finished frame.
+    const FrameProfile& Last() const;
+
+    // The p-th percentile (0..100) of a phase over the history, in nanoseconds.
+    // Pass PHASE_COUNT to get the whole-frame time instead of a single phase.
+    uint32_t Percentile(int phase, float p);
+
+    // Count how many recorded frames fall into each of 'binCount' frame-time bins 'binNanos' wide.
+    // The last bin also collects every slower frame.
+    void FrameHistogram(int* bins, int binCount, uint32_t binNanos) const;
+
+    // Write the history, oldest frame first, as CSV with one column per phase (microseconds).
+    bool DumpCsv(const char* path) const;
+};
+
+// Measures the time from construction to destruction and adds it to one phase.
+struct ProfileScope {
+    FrameProfiler* profiler;
+    int phase;
+    uint64_t start;
+
+    ProfileScope(FrameProfiler* owner, int scopePhase)
+        : profiler(owner && owner->enabled ? owner : nullptr), phase(scopePhase),
+          start(profiler ? ProfileNow() : 0) {}
+    ~ProfileScope() {
+        if (profiler) {
+            profiler->Add(phase, ProfileNow() - start);
+        }
+    }
+};
+
+#endif // AXE_GAME_PROFILER_H
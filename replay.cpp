@@ -0,0 +1,174 @@
+#include "replay.h"
+
+#include <cstdio>  // File I/O.
+#include <cstring> // memcmp for the magic.
+
+// Replays hold an hour of ticks before the input vector has to grow.
+const int kReplayReserveTicks = kTickRate * 60 * 60;
+
+static void PutU16(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+static void PutU32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<uint8_t>(value >> shift));
+    }
+}
+
+static uint16_t GetU16(const uint8_t* data) {
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+static uint32_t GetU32(const uint8_t* data) {
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+           (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+static uint32_t Fnv1a(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+void Replay::Begin(int newAxeCount, uint32_t newSeed, uint32_t newConfigHash) {
+    seed = newSeed;
+    axeCount = newAxeCount;
+    configHash = newConfigHash;
+    tickRate = kTickRate;
+    claimedScore = 0;
+    inputs.clear();
+    inputs.reserve(kReplayReserveTicks);
+}
+
+std::vector<uint8_t> Replay::Encode() const {
+    // Run-length encode the inputs first so the header can record the payload size.
+    std::vector<uint8_t> payload;
+    for (size_t i = 0; i < inputs.size();) {
+        size_t run = 1;
+        while (i + run < inputs.size() && inputs[i + run] == inputs[i]) {
+            ++run;
+        }
+        payload.push_back(inputs[i]);
+        for (size_t remaining = run; ; remaining >>= 7) { // LEB128: 7 bits per byte, high bit = more.
+            uint8_t byte = static_cast<uint8_t>(remaining & 0x7F);
+            if (remaining >= 0x80) {
+                payload.push_back(byte | 0x80);
+            } else {
+                payload.push_back(byte);
+                break;
+            }
+        }
+        i += run;
+    }
+
+    std::vector<uint8_t> out;
+    out.reserve(32 + payload.size());
+    out.insert(out.end(), {'A', 'X', 'R', 'P'});
+    PutU16(out, kReplayVersion);
+    PutU16(out, tickRate);
+    PutU32(out, seed);
+    PutU32(out, configHash);
+    PutU32(out, static_cast<uint32_t>(axeCount));
+    PutU32(out, static_cast<uint32_t>(inputs.size()));
+    PutU32(out, static_cast<uint32_t>(claimedScore));
+    PutU32(out, static_cast<uint32_t>(payload.size()));
+    out.insert(out.end(), payload.begin(), payload.end());
+    PutU32(out, Fnv1a(payload.data(), payload.size()));
+    return out;
+}
+
+bool Replay::Decode(const uint8_t* data, size_t size, uint32_t maxTicks, int maxAxes) {
+    const size_t headerSize = 4 + 2 + 2 + 4 * 6;
+    if (size < headerSize + 4 || memcmp(data, "AXRP", 4) != 0 || GetU16(data + 4) != kReplayVersion) {
+        return false;
+    }
+    tickRate = GetU16(data + 6);
+    seed = GetU32(data + 8);
+    configHash = GetU32(data + 12);
+    uint32_t headerAxes = GetU32(data + 16);
+    uint32_t tickCount = GetU32(data + 20);
+    claimedScore = static_cast<int>(GetU32(data + 24));
+    uint32_t payloadSize = GetU32(data + 28);
+    if (payloadSize > size - headerSize - 4) {
+        return false; // Truncated file.
+    }
+    if (tickCount > maxTicks) {
+        return false; // Longer than the caller is willing to hold.
+    }
+    if (headerAxes < 1 || maxAxes < 1 || headerAxes > static_cast<uint32_t>(maxAxes)) {
+        return false; // No game has zero axes, and World::Reset would allocate for all of them.
+    }
+    axeCount = static_cast<int>(headerAxes);
+    const uint8_t* payload = data + headerSize;
+    if (Fnv1a(payload, payloadSize) != GetU32(payload + payloadSize)) {
+        return false; // Corrupted payload.
+    }
+
+    // No reserve from 'tickCount': it is only trusted once the runs actually add up to it.
+    inputs.clear();
+    for (uint32_t offset = 0; offset < payloadSize;) {
+        InputMask input = payload[offset++];
+        uint32_t run = 0;
+        for (int shift = 0; ; shift += 7) {
+            if (offset >= payloadSize || shift > 28) {
+                return false; // Run length cut off or longer than 32 bits.
+            }
+            uint8_t byte = payload[offset++];
+            run |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                break;
+            }
+        }
+        if (run > tickCount - inputs.size()) {
+            return false; // More ticks than the header promised.
+        }
+        inputs.insert(inputs.end(), run, input);
+    }
+    return inputs.size() == tickCount;
+}
+
+bool Replay::Save(const char* path) const {
+    std::vector<uint8_t> bytes = Encode();
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    bool written = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return (fclose(file) == 0) && written;
+}
+
+bool Replay::Load(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    std::vector<uint8_t> bytes;
+    uint8_t buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        bytes.insert(bytes.end(), buffer, buffer + read);
+    }
+    fclose(file);
+    return Decode(bytes.data(), bytes.size());
+}
+
+ReplayResult SimulateReplay(const Replay& replay, World& world) {
+    ReplayResult result = {0, 0, false, replay.configHash == SimulationConfigHash(world.config) && replay.tickRate == kTickRate,
+                           false};
+    world.Reset(replay.axeCount, replay.seed);
+    for (InputMask input : replay.inputs) {
+        ++result.ticks;
+        if (world.Step(kTickSeconds, input)) {
+            break;
+        }
+    }
+    result.score = world.score;
+    result.collided = world.collided;
+    result.verified = result.configMatches && result.collided &&
+                      result.ticks == static_cast<int>(replay.inputs.size()) && result.score == replay.claimedScore;
+    return result;
+}
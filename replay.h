@@ -0,0 +1,77 @@
+#ifndef AXE_GAME_REPLAY_H
+#define AXE_GAME_REPLAY_H
+
+// Deterministic input recording and replay.
+// The simulation is fully determined by its seed, its axe count, the tuning constants and the input
+// bitmask of every tick. A replay stores exactly that: a small header plus the per-tick inputs,
+// run-length encoded (a held key costs a couple of bytes per run, not one byte per tick). Feeding a
+// replay back through World::Step reproduces the original game bit for bit, headless or rendered,
+// as fast as the CPU allows.
+//
+// File layout (all integers little-endian):
+//   "AXRP"  magic
+//   u16     format version (kReplayVersion)
+//   u16     tick rate the game was recorded at
+//   u32     seed passed to World::Reset
+//   u32     SimulationConfigHash() of the rules the game was played with
+//   u32     axe count passed to World::Reset
+//   u32     number of ticks
+//   i32     final score claimed by the recording
+//   u32     payload size in bytes
+//   ...     payload: runs of (u8 input mask, LEB128 run length)
+//   u32     FNV-1a checksum of the payload
+
+#include <cstddef> // size_t for buffer sizes.
+#include <cstdint> // Fixed-width header fields.
+#include <vector>  // Input storage.
+
+#include "simulation.h" // InputMask, World.
+
+const uint16_t kReplayVersion = 1;
+// Longest replay Decode() accepts by default: a day of play. The tick count comes from the file,
+// so without a limit a forged header could make the decoder allocate without bound.
+const uint32_t kMaxReplayTicks = kTickRate * 60 * 60 * 24;
+// Most axes Decode() accepts by default, far beyond anything playable. World::Reset allocates for
+// the header's axe count, so it is bounded for the same reason.
+const int kMaxReplayAxes = 100000;
+
+struct Replay {
+    uint32_t seed = 1u;               // World::Reset seed.
+    uint32_t configHash = 0;          // SimulationConfigHash() of the rules at record time.
+    uint16_t tickRate = kTickRate;    // Ticks per second at record time.
+    int axeCount = 1;                 // World::Reset axe count.
+    int claimedScore = 0;             // Score the recorded game ended with.
+    std::vector<InputMask> inputs;    // One input mask per tick, decoded.
+
+    // Start a new recording for a game reset with 'axeCount' and 'seed' under the rules hashed as
+    // 'configHash' (SimulationConfigHash of the world's config). Space for an hour of
+    // ticks is reserved up front so recording never allocates during play.
+    void Begin(int newAxeCount, uint32_t newSeed, uint32_t newConfigHash);
+
+    // Append the input used for one tick.
+    void Record(InputMask input) { inputs.push_back(input); }
+
+    // Serialize to / parse from the file layout described above. Decode() rejects replays longer
+    // than 'maxTicks', or with an axe count outside 1..'maxAxes', before storing any input.
+    std::vector<uint8_t> Encode() const;
+    bool Decode(const uint8_t* data, size_t size, uint32_t maxTicks = kMaxReplayTicks, int maxAxes = kMaxReplayAxes);
+
+    // Write to / read from a file. Return false on I/O or format errors.
+    bool Save(const char* path) const;
+    bool Load(const char* path);
+};
+
+// Outcome of re-simulating a replay.
+struct ReplayResult {
+    int ticks;          // Ticks actually simulated (stops early at a collision).
+    int score;          // Score at the end of the simulation.
+    bool collided;      // True if the game ended with the player being hit.
+    bool configMatches; // True if the replay was recorded with this build's tuning.
+    bool verified;      // True if the replay ends in a collision on its last tick with its claimed score.
+};
+
+// Play 'replay' through 'world' from a fresh Reset to its last tick and check its claims.
+// The world's config must match the rules the replay was recorded with (see configMatches).
+ReplayResult SimulateReplay(const Replay& replay, World& world);
+
+#endif // AXE_GAME_REPLAY_H
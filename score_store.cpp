@@ -0,0 +1,213 @@
+#include "score_store.h"
+
+#include <cstddef> // size_t for checksums.
+#include <cstring> // memcmp for the header magic.
+
+// POSIX maps the log; Windows has no mmap, so it reads the whole file with one _read instead.
+// Everything else goes through the same small set of file-descriptor calls on both.
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#define SCORE_OPEN(path) _open(path, _O_RDWR | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE)
+#define SCORE_CLOSE _close
+#define SCORE_SYNC _commit
+#define SCORE_TRUNCATE _chsize
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SCORE_OPEN(path) open(path, O_RDWR | O_CREAT, 0644)
+#define SCORE_CLOSE close
+#define SCORE_SYNC fsync
+#define SCORE_TRUNCATE ftruncate
+#endif
+
+const char kScoreMagic[4] = {'A', 'X', 'H', 'S'};
+const long long kScoreHeaderSize = 16;
+
+struct ScoreHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t reserved;
+};
+
+static uint32_t Fnv1a(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static uint32_t RecordChecksum(const ScoreRecord& record) {
+    return Fnv1a(reinterpret_cast<const uint8_t*>(&record), offsetof(ScoreRecord, checksum));
+}
+
+// Write all of 'size' bytes at 'offset'. Returns false on any error.
+static bool WriteAt(int fd, long long offset, const void* data, unsigned size) {
+#if defined(_WIN32)
+    if (_lseeki64(fd, offset, SEEK_SET) != offset) {
+        return false;
+    }
+    return _write(fd, data, size) == static_cast<int>(size);
+#else
+    return pwrite(fd, data, size, static_cast<off_t>(offset)) == static_cast<ssize_t>(size);
+#endif
+}
+
+bool ScoreStore::Open(const char* filePath) {
+    Close();
+    path = filePath;
+    bests.clear();
+    nextSequence = 0;
+    validBytes = kScoreHeaderSize;
+
+    int fd = SCORE_OPEN(filePath);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        SCORE_CLOSE(fd);
+        return false;
+    }
+    long long size = static_cast<long long>(info.st_size);
+
+    if (size > 0) {
+        // Load: one mapping (or one read), then walk the records in place.
+#if defined(_WIN32)
+        std::vector<uint8_t> buffer(static_cast<size_t>(size));
+        _lseeki64(fd, 0, SEEK_SET);
+        const uint8_t* bytes = _read(fd, buffer.data(), static_cast<unsigned>(size)) == size ? buffer.data() : nullptr;
+#else
+        void* mapping = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_PRIVATE, fd, 0);
+        const uint8_t* bytes = mapping != MAP_FAILED ? static_cast<const uint8_t*>(mapping) : nullptr;
+#endif
+        const ScoreHeader* header = reinterpret_cast<const ScoreHeader*>(bytes);
+        bool valid = bytes && size >= kScoreHeaderSize && memcmp(header->magic, kScoreMagic, 4) == 0 &&
+                     header->version == kScoreStoreVersion && header->recordSize == sizeof(ScoreRecord);
+        if (valid) {
+            const ScoreRecord* records = reinterpret_cast<const ScoreRecord*>(bytes + kScoreHeaderSize);
+            long long count = (size - kScoreHeaderSize) / static_cast<long long>(sizeof(ScoreRecord));
+            // Stop at the first record that is torn, corrupt or out of sequence; the log ends there.
+            for (long long i = 0; i < count; ++i) {
+                const ScoreRecord& record = records[i];
+                if (record.sequence != nextSequence || record.checksum != RecordChecksum(record)) {
+                    break;
+                }
+                UpdateBest(record.score, static_cast<int>(record.axeCount));
+                ++nextSequence;
+            }
+            validBytes = kScoreHeaderSize + static_cast<long long>(nextSequence) * sizeof(ScoreRecord);
+        }
+#if !defined(_WIN32)
+        if (bytes) {
+            munmap(mapping, static_cast<size_t>(size));
+        }
+#endif
+        if (!valid) {
+            SCORE_CLOSE(fd); // Not a score log (or a newer format): leave it alone.
+            return false;
+        }
+    } else {
+        ScoreHeader header = {{kScoreMagic[0], kScoreMagic[1], kScoreMagic[2], kScoreMagic[3]},
+                              kScoreStoreVersion, sizeof(ScoreRecord), 0u};
+        if (!WriteAt(fd, 0, &header, sizeof(header)) || SCORE_SYNC(fd) != 0) {
+            SCORE_CLOSE(fd);
+            return false;
+        }
+    }
+
+    // Drop a torn tail so the next append starts right after the last good record.
+    if (validBytes < size) {
+        SCORE_TRUNCATE(fd, static_cast<long>(validBytes));
+    }
+
+    file = fd;
+    stopping = false;
+    writeFailed = false;
+    writer = std::thread(&ScoreStore::RunWriter, this);
+    return true;
+}
+
+void ScoreStore::Close() {
+    if (writer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        writer.join(); // The writer drains the queue before it exits.
+    }
+    if (file >= 0) {
+        SCORE_CLOSE(file);
+        file = -1;
+    }
+}
+
+int ScoreStore::Best(int axeCount) const {
+    for (const BestEntry& entry : bests) {
+        if (entry.axeCount == axeCount) {
+            return entry.score;
+        }
+    }
+    return 0;
+}
+
+void ScoreStore::Submit(int score, int axeCount) {
+    UpdateBest(score, axeCount);
+
+    ScoreRecord record;
+    record.sequence = nextSequence++;
+    record.score = score;
+    record.axeCount = static_cast<uint32_t>(axeCount);
+    record.checksum = RecordChecksum(record);
+    if (!writer.joinable()) {
+        return; // No file: the score still counts for this session.
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(record);
+    }
+    wake.notify_one();
+}
+
+void ScoreStore::UpdateBest(int score, int axeCount) {
+    for (BestEntry& entry : bests) {
+        if (entry.axeCount == axeCount) {
+            entry.score = score > entry.score ? score : entry.score;
+            return;
+        }
+    }
+    bests.push_back(BestEntry{axeCount, score});
+}
+
+void ScoreStore::RunWriter() {
+    std::vector<ScoreRecord> batch;
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [this] { return stopping || !pending.empty(); });
+        if (pending.empty()) {
+            return; // Stopping and nothing left to write.
+        }
+        batch.swap(pending);
+        lock.unlock();
+
+        // One append and one flush per record: a crash can then tear at most the last one.
+        for (const ScoreRecord& record : batch) {
+            if (writeFailed || !WriteAt(file, validBytes, &record, sizeof(record))) {
+                // Disk full or file gone. Later records would leave a gap in the sequence, so stop
+                // appending; the bests still live in memory for this session.
+                writeFailed = true;
+                break;
+            }
+            SCORE_SYNC(file);
+            validBytes += sizeof(record);
+        }
+        batch.clear();
+        lock.lock();
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef AXE_GAME_SCORE_STORE_H
+#define AXE_GAME_SCORE_STORE_H
+
+// Persistent high score store.
+// Scores live in an append-only log of fixed-size, checksummed records. Loading maps the file once
+// and reads the records in place; nothing is parsed. Saving hands the record to a background writer
+// thread, so finishing a game never waits for the disk. Every record is written with a single
+// append and flushed to stable storage before the next one, so a crash or power cut can at worst
+// leave one torn record at the end of the log. Its checksum fails, it is ignored on the next start
+// and overwritten by the next append.
+//
+// File layout (host byte order, 16-byte header then 16-byte records):
+//   "AXHS"  magic
+//   u32     format version (kScoreStoreVersion)
+//   u32     record size in bytes (sizeof(ScoreRecord))
+//   u32     reserved, zero
+//   ...     ScoreRecord entries, oldest first
+
+#include <condition_variable> // Waking the writer thread.
+#include <cstdint>            // Fixed-width record fields.
+#include <mutex>              // Guards the pending queue.
+#include <string>             // File path.
+#include <thread>             // Background writer.
+#include <vector>             // Pending records and per-variant bests.
+
+const uint32_t kScoreStoreVersion = 1;
+
+struct ScoreRecord {
+    uint32_t sequence; // Position in the log, starting at 0. Guards against stale or shuffled records.
+    int32_t score;     // Final score of the game.
+    uint32_t axeCount; // Variant played; each axe count keeps its own best.
+    uint32_t checksum; // FNV-1a of the three fields above.
+};
+
+struct ScoreStore {
+    // Open (or create) the log at 'path', load every valid record and start the writer thread.
+    // Returns false if the file cannot be opened; the store then still tracks bests in memory.
+    bool Open(const char* path);
+
+    // Write out everything still queued and stop the writer thread. Called by the destructor.
+    void Close();
+
+    ~ScoreStore() { Close(); }
+
+    // Best score ever recorded for games with 'axeCount' axes, or 0.
+    int Best(int axeCount) const;
+
+    // Record a finished game. Updates Best() immediately and queues the disk write; never blocks on I/O.
+    void Submit(int score, int axeCount);
+
+    // Internal state.
+    struct BestEntry {
+        int axeCount;
+        int score;
+    };
+    std::vector<BestEntry> bests;       // Best score per variant seen so far.
+    uint32_t nextSequence = 0;          // Sequence number of the next record.
+    std::string path;                   // Log file.
+    int file = -1;                      // Open file descriptor of the log, or -1.
+    long long validBytes = 0;           // Length of the intact part of the log; owned by the writer.
+    bool writeFailed = false;           // Set by the writer after an I/O error; no more appends.
+
+    std::thread writer;                 // Appends queued records in the background.
+    std::mutex mutex;                   // Guards 'pending' and 'stopping'.
+    std::condition_variable wake;       // Signalled when records are queued or on Close().
+    std::vector<ScoreRecord> pending;   // Records waiting for the writer.
+    bool stopping = false;
+
+    void UpdateBest(int score, int axeCount);
+    void RunWriter();
+};
+
+#endif // AXE_GAME_SCORE_STORE_H
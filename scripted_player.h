@@ -0,0 +1,31 @@
+#ifndef AXE_GAME_SCRIPTED_PLAYER_H
+#define AXE_GAME_SCRIPTED_PLAYER_H
+
+// Cheap stand-in for a human player in headless runs.
+// It holds a random combination of directions for a random number of ticks, then picks a new one.
+// Deterministic for a given seed, so a batch with the same seeds always plays the same games.
+
+#include "simulation.h" // InputMask and Rng.
+
+struct ScriptedPlayer {
+    Rng rng;
+    InputMask input = INPUT_NONE;
+    int holdTicks = 0;
+
+    explicit ScriptedPlayer(uint32_t seed) : rng(seed) {}
+
+    // Input for the next tick.
+    InputMask Next() {
+        if (holdTicks == 0) {
+            input = static_cast<InputMask>(rng.Next() & 0x0F);
+            holdTicks = 5 + static_cast<int>(rng.Next() % 40);
+        }
+        --holdTicks;
+        return input;
+    }
+
+    // The same, as a Controller (see controller.h); the script does not look at the world.
+    InputMask Next(const World&) { return Next(); }
+};
+
+#endif // AXE_GAME_SCRIPTED_PLAYER_H
@@ -0,0 +1,271 @@
+#include "simulation.h"
+
+#include "build_profile.h" // Fixed playfield and player speed in specialized builds.
+#include "telemetry.h"     // Speed ramp and collision events.
+
+#include <cmath>   // fabsf for the collision tests and speed caps.
+#include <cstddef> // size_t for hashing.
+
+bool CircleOverlapsSquare(float centerX, float centerY, float radius, float x, float y, float length) {
+    // Same steps as raylib's CheckCollisionCircleRec: compare the circle's center against the
+    // square's center on each axis, then fall back to the corner distance.
+    float halfLength = length / 2.0f;
+    int squareCenterX = static_cast<int>(x + halfLength);
+    int squareCenterY = static_cast<int>(y + halfLength);
+
+    float dx = fabsf(centerX - static_cast<float>(squareCenterX));
+    float dy = fabsf(centerY - static_cast<float>(squareCenterY));
+
+    if (dx > halfLength + radius) { return false; } // Too far apart horizontally.
+    if (dy > halfLength + radius) { return false; } // Too far apart vertically.
+    if (dx <= halfLength) { return true; }          // Circle center is within the square's column.
+    if (dy <= halfLength) { return true; }          // Circle center is within the square's row.
+
+    // Otherwise only a square corner can touch the circle.
+    float cornerDistanceSq = (dx - halfLength) * (dx - halfLength) + (dy - halfLength) * (dy - halfLength);
+    return cornerDistanceSq <= radius * radius;
+}
+
+// True if the segment from (x0, y0) to (x1, y1) touches the box [minX, maxX] x [minY, maxY].
+// Classic slab test: clip the segment's parameter range against each axis in turn.
+static bool SegmentHitsBox(float x0, float y0, float x1, float y1, float minX, float minY, float maxX, float maxY) {
+    float tEnter = 0.0f;
+    float tExit = 1.0f;
+    float start[2] = {x0, y0};
+    float delta[2] = {x1 - x0, y1 - y0};
+    float boxMin[2] = {minX, minY};
+    float boxMax[2] = {maxX, maxY};
+    for (int axis = 0; axis < 2; ++axis) {
+        if (delta[axis] == 0.0f) {
+            if (start[axis] < boxMin[axis] || start[axis] > boxMax[axis]) {
+                return false; // Parallel to this slab and outside it.
+            }
+            continue;
+        }
+        float t0 = (boxMin[axis] - start[axis]) / delta[axis];
+        float t1 = (boxMax[axis] - start[axis]) / delta[axis];
+        if (t0 > t1) {
+            float swap = t0;
+            t0 = t1;
+            t1 = swap;
+        }
+        tEnter = t0 > tEnter ? t0 : tEnter;
+        tExit = t1 < tExit ? t1 : tExit;
+        if (tEnter > tExit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// True if the segment from (x0, y0) to (x1, y1) passes within 'radius' of (centerX, centerY).
+static bool SegmentHitsCircle(float x0, float y0, float x1, float y1, float centerX, float centerY, float radius) {
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    float lengthSq = dx * dx + dy * dy;
+    float t = 0.0f;
+    if (lengthSq > 0.0f) {
+        t = ((centerX - x0) * dx + (centerY - y0) * dy) / lengthSq;
+        t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+    }
+    float closestX = x0 + dx * t - centerX;
+    float closestY = y0 + dy * t - centerY;
+    return closestX * closestX + closestY * closestY <= radius * radius;
+}
+
+bool SweptCircleHitsSquare(float prevCenterX, float prevCenterY, float centerX, float centerY, float radius,
+                           float prevX, float prevY, float x, float y, float length) {
+    // The end-of-step test keeps results identical to the discrete check when nothing moves fast.
+    if (CircleOverlapsSquare(centerX, centerY, radius, x, y, length)) {
+        return true;
+    }
+
+    // Work in the square's frame of reference: the square sits still at [0, length]^2 and the circle's
+    // center travels along the segment of its motion relative to the square.
+    float x0 = prevCenterX - prevX;
+    float y0 = prevCenterY - prevY;
+    float x1 = centerX - x;
+    float y1 = centerY - y;
+
+    // The circle touches the square exactly when its center is inside the square grown by 'radius'
+    // with rounded corners: two overlapping boxes (one widened, one heightened) plus four corner circles.
+    return SegmentHitsBox(x0, y0, x1, y1, -radius, 0.0f, length + radius, length) ||
+           SegmentHitsBox(x0, y0, x1, y1, 0.0f, -radius, length, length + radius) ||
+           SegmentHitsCircle(x0, y0, x1, y1, 0.0f, 0.0f, radius) ||
+           SegmentHitsCircle(x0, y0, x1, y1, length, 0.0f, radius) ||
+           SegmentHitsCircle(x0, y0, x1, y1, 0.0f, length, radius) ||
+           SegmentHitsCircle(x0, y0, x1, y1, length, length, radius);
+}
+
+bool CheckCollision(const Player& player, const Axe& axe) {
+    return SweptCircleHitsSquare(player.prevX, player.prevY, player.x, player.y, static_cast<float>(player.radius),
+                                 axe.prevX, axe.prevY, axe.x, axe.y, axe.length);
+}
+
+void World::Reset(int axeCount, uint32_t seed) {
+    const float startX = config.screenWidth / 2;
+    const float startY = config.screenHeight / 2;
+    player = {startX, startY, config.playerRadius, startX, startY};
+
+    if (axeCount < 1) {
+        axeCount = 1;
+    }
+    axes.Reserve(axeCount);
+    axes.Clear();
+    grid.Init(config.screenWidth, config.screenHeight, axes.capacity);
+    // Axe starts with initial horizontal and vertical speeds, creating an immediate diagonal movement.
+    axes.Spawn(config.axeStartX, config.axeStartY, config.axeStartSpeedX, config.axeStartSpeedY, config.axeLength);
+    // Extra axes get a random spot along the top band and a random diagonal direction at the
+    // classic starting speeds.
+    Rng rng(seed);
+    for (int i = 1; i < axeCount; ++i) {
+        float spawnX = rng.NextFloat() * (config.screenWidth - config.axeLength);
+        float spawnY = rng.NextFloat() * (config.bulletHellSpawnHeight - config.axeLength);
+        float speedX = (rng.Next() & 1) ? config.axeStartSpeedX : -config.axeStartSpeedX;
+        float speedY = (rng.Next() & 1) ? config.axeStartSpeedY : -config.axeStartSpeedY;
+        axes.Spawn(spawnX, spawnY, speedX, speedY, config.axeLength);
+    }
+    // The other obstacle types spawn in the same band, after the bullet hell axes so adding them
+    // never changes where those appear.
+    obstacles.Clear();
+    for (int i = 0; i < config.spinningAxes; ++i) {
+        float spawnX = rng.NextFloat() * (config.screenWidth - config.axeLength);
+        float spawnY = rng.NextFloat() * (config.bulletHellSpawnHeight - config.axeLength);
+        float speedX = (rng.Next() & 1) ? config.axeStartSpeedX : -config.axeStartSpeedX;
+        float speedY = (rng.Next() & 1) ? config.axeStartSpeedY : -config.axeStartSpeedY;
+        float spin = (rng.Next() & 1) ? config.spinSpeed : -config.spinSpeed;
+        SpawnSpinningAxe(obstacles, spawnX, spawnY, speedX, speedY, config.axeLength, spin);
+    }
+    for (int i = 0; i < config.homingAxes; ++i) {
+        float spawnX = rng.NextFloat() * (config.screenWidth - config.axeLength);
+        float spawnY = rng.NextFloat() * (config.bulletHellSpawnHeight - config.axeLength);
+        SpawnHomingAxe(obstacles, spawnX, spawnY, config.axeLength, config.homingSpeed, config.homingTurnRate);
+    }
+    grid.Update(axes);
+    hitAxe = -1;
+    hitObstacle = Entity();
+    score = 0;
+    scoreTimer = 0.0f;
+    lastSpeedIncreaseScore = 0;
+    collided = false;
+    bounces = 0;
+    speedRamped = false;
+}
+
+bool World::Step(float deltaTime, InputMask input) {
+    if (collided) {
+        bounces = 0;
+        speedRamped = false;
+        return true; // The game is already over; nothing moves anymore.
+    }
+
+    // Remember where everything was so the renderer can interpolate towards the new positions.
+    // The axe pool records its own previous positions as part of AxePool::Move.
+    player.prevX = player.x;
+    player.prevY = player.y;
+
+    // Update game entities' positions. In a fixed-profile build 'bounds' is a FixedBounds and the
+    // playfield edges are compile-time constants.
+    const auto bounds = BuildProfile::Bounds(config);
+    {
+        ProfileScope scope(profiler, PHASE_PLAYER_MOVE);
+        player.MoveWithin(bounds, BuildProfile::PlayerSpeed(config), deltaTime, input);
+    }
+    {
+        ProfileScope scope(profiler, PHASE_AXE_MOVE);
+        bounces = axes.Move(bounds.Width(), bounds.Height(), deltaTime);
+        grid.Update(axes);
+        SteerHomingObstacles(obstacles, player.x, player.y, deltaTime);
+        bounces += MoveObstacles(obstacles, bounds.Width(), bounds.Height(), deltaTime);
+        SpinObstacles(obstacles, deltaTime);
+    }
+
+    // Update score based on survival time (1 point per second).
+    scoreTimer += deltaTime;
+    if (scoreTimer >= 1.0f) { // Every second, increment score.
+        score += 1;
+        scoreTimer -= 1.0f; // Subtract 1.0f to maintain precision for remaining time.
+    }
+
+    // Increase axe speed every speedRampInterval points to make the game progressively harder.
+    speedRamped = false;
+    if (score > lastSpeedIncreaseScore && score % config.speedRampInterval == 0) {
+        // Collision is swept (see SweptCircleHitsSquare), so fast axes cannot tunnel through the
+        // player; the caps only keep the top difficulty tier playable. They apply to the speed's
+        // magnitude so an axe heading left or up is capped just like one heading right or down.
+        // Every axe ramps on the same beat; free slots have zero speed and stay that way.
+        for (int i = 0; i < axes.highWater; ++i) {
+            if (fabsf(axes.vx[i]) < config.maxAxeSpeedX) {
+                axes.vx[i] *= config.speedRampFactor;
+            }
+            if (fabsf(axes.vy[i]) < config.maxAxeSpeedY) {
+                axes.vy[i] *= config.speedRampFactor;
+            }
+        }
+        RampObstacles(obstacles, config.speedRampFactor, config.maxAxeSpeedX, config.maxAxeSpeedY);
+        lastSpeedIncreaseScore = score; // Update the last score at which speed was increased.
+        speedRamped = true;
+        if (telemetry) {
+            telemetry->Emit(TELEMETRY_SPEED_RAMP, score, axes.vx[0], axes.vy[0]);
+        }
+    }
+
+    // Check for collision between the player and the axes near it.
+    ProfileScope scope(profiler, PHASE_COLLISION);
+    hitAxe = grid.FindCollision(axes, player.prevX, player.prevY, player.x, player.y,
+                                static_cast<float>(player.radius), deltaTime);
+    if (hitAxe < 0) {
+        hitObstacle = FindObstacleCollision(obstacles, player.prevX, player.prevY, player.x, player.y,
+                                            static_cast<float>(player.radius));
+    }
+    collided = hitAxe >= 0 || obstacles.Alive(hitObstacle);
+    if (collided && telemetry) {
+        telemetry->Emit(TELEMETRY_COLLISION, hitAxe, player.x, player.y);
+    }
+    return collided;
+}
+
+uint32_t SimulationConfigHash(const GameConfig& config) {
+    // FNV-1a over the values in a fixed order. Floats are hashed by their bit patterns.
+    const float values[] = {
+        static_cast<float>(config.screenWidth), static_cast<float>(config.screenHeight),
+        static_cast<float>(config.playerRadius), config.playerSpeed, static_cast<float>(config.axeStartX),
+        static_cast<float>(config.axeStartY), static_cast<float>(config.axeLength), config.axeStartSpeedX,
+        config.axeStartSpeedY, static_cast<float>(config.speedRampInterval), config.speedRampFactor,
+        config.maxAxeSpeedX, config.maxAxeSpeedY, static_cast<float>(config.bulletHellSpawnHeight),
+        static_cast<float>(kTickRate),
+    };
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(values);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(values); ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    // The extra obstacle types are only hashed when any are in play, so every game recorded before
+    // they existed (and every classic game since) keeps its hash.
+    if (config.spinningAxes > 0 || config.homingAxes > 0) {
+        const float obstacleValues[] = {
+            static_cast<float>(config.spinningAxes), static_cast<float>(config.homingAxes), config.spinSpeed,
+            config.homingSpeed, config.homingTurnRate,
+        };
+        bytes = reinterpret_cast<const unsigned char*>(obstacleValues);
+        for (size_t i = 0; i < sizeof(obstacleValues); ++i) {
+            hash = (hash ^ bytes[i]) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+int FixedStepClock::Advance(float frameTime, int maxTicks) {
+    accumulator += frameTime;
+    int ticks = static_cast<int>(accumulator / kTickSeconds);
+    if (ticks > maxTicks) {
+        ticks = maxTicks;
+        accumulator = 0.0f; // Drop the backlog instead of trying to catch up over many frames.
+        return ticks;
+    }
+    accumulator -= ticks * kTickSeconds;
+    if (accumulator < 0.0f) {
+        accumulator = 0.0f; // Guard against float rounding pushing the remainder below zero.
+    }
+    return ticks;
+}
@@ -0,0 +1,281 @@
+#ifndef AXE_GAME_SIMULATION_H
+#define AXE_GAME_SIMULATION_H
+
+// Headless simulation core for Axe Game.
+// Nothing in this header (or in simulation.cpp) touches raylib: there is no window, no GPU and no
+// keyboard polling here. Time and input are passed in explicitly, which means the exact same game
+// rules can run inside the rendered game, on a CI machine, or in a balancing farm at thousands of
+// games per second.
+
+#include <cstdint> // Fixed-width integer types for the input bitmask.
+
+#include "axe_grid.h"  // Broad-phase grid for player-vs-axe collision.
+#include "axe_pool.h"  // Structure-of-arrays storage for all axes in a game.
+#include "obstacles.h" // Spinning and homing axes as ECS entities.
+#include "profiler.h"  // Optional per-phase timing of Step().
+
+struct TelemetryStream; // Optional gameplay events (telemetry.h).
+
+// Input bitmask describing which movement directions are held during a simulation step.
+// A plain bitmask is tiny, trivially copyable and easy to generate from a script or a bot,
+// so the simulation never needs to know where the input came from.
+enum InputBits : uint8_t {
+    INPUT_NONE  = 0,
+    INPUT_RIGHT = 1 << 0, // D or Right Arrow
+    INPUT_LEFT  = 1 << 1, // A or Left Arrow
+    INPUT_UP    = 1 << 2, // W or Up Arrow
+    INPUT_DOWN  = 1 << 3  // S or Down Arrow
+};
+typedef uint8_t InputMask;
+
+// Gameplay tuning. These used to be literals scattered through main() and its reset blocks; keeping
+// them in one struct guarantees the rendered game and headless runs play by the same rules, and lets
+// the game load them from a file (see game_config.h) so they can be tuned without recompiling.
+// The defaults below are the shipped rules.
+struct GameConfig {
+    int screenWidth = 800;             // Width of the playfield in pixels.
+    int screenHeight = 450;            // Height of the playfield in pixels.
+    int playerRadius = 25;             // Radius of the circular player.
+    float playerSpeed = 300.0f;        // Player speed in pixels per second.
+    int axeStartX = 300;               // Initial X position of the axe's top-left corner.
+    int axeStartY = 0;                 // Initial Y position of the axe's top-left corner.
+    int axeLength = 50;                // Side length of the square axe.
+    float axeStartSpeedX = 150.0f;     // Initial horizontal axe speed (pixels per second).
+    float axeStartSpeedY = 200.0f;     // Initial vertical axe speed (pixels per second).
+    int speedRampInterval = 10;        // The axe speeds up every this many points.
+    float speedRampFactor = 1.1f;      // Multiplier applied to the axe speed on each ramp (+10%).
+    float maxAxeSpeedX = 900.0f;       // Horizontal speed cap. Collision is swept, so this is a
+    float maxAxeSpeedY = 1200.0f;      // difficulty choice only; fast axes cannot tunnel through.
+    int bulletHellSpawnHeight = 140;   // Extra axes spawn above this line, clear of the player.
+    int spinningAxes = 0;              // Extra rotating axes (see obstacles.h), spawned like bullet hell axes.
+    int homingAxes = 0;                // Extra axes that steer towards the player.
+    float spinSpeed = 2.0f;            // Angular speed of spinning axes in radians per second.
+    float homingSpeed = 120.0f;        // Speed of homing axes in pixels per second.
+    float homingTurnRate = 1.5f;       // How quickly homing axes turn towards the player (per second).
+
+    // Frame pacing per game state (see StatePacer in input.h). Presentation only: never hashed, so
+    // changing them cannot invalidate a replay.
+    int playingFps = 0;                // Frame rate cap while playing; 0 means as fast as VSync allows.
+    int menuFps = 0;                   // Cap on the menu; 0 means redraw only on input or the idle timer.
+    int gameOverFps = 0;               // The same for the game over screen.
+    int idleRedrawMs = 500;            // Idle timer: the longest an idle screen goes without a redraw.
+};
+
+// Fixed simulation tick. The world always advances in steps of exactly kTickSeconds, no matter how
+// fast frames are rendered, so results are deterministic and the cost per simulated second is flat.
+// Positions are sub-pixel floats, so a short step still moves things by a fraction of a pixel instead
+// of truncating to zero; 120 Hz halves the delay between a key press and the step that reacts to it.
+const int kTickRate = 120;                   // Simulation steps per second.
+const float kTickSeconds = 1.0f / kTickRate; // Length of one simulation step in seconds.
+const int kMaxCatchUpTicks = 16;             // Most steps run for a single rendered frame.
+
+// Playfield size as seen by the movement rules. RuntimeBounds carries the size from a GameConfig;
+// FixedBounds carries it in its type, so movement code instantiated with it compares against
+// constants the compiler can fold. Fixed-profile builds use the latter (see build_profile.h).
+struct RuntimeBounds {
+    int width;
+    int height;
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+};
+
+template <int ScreenWidth, int ScreenHeight>
+struct FixedBounds {
+    static_assert(ScreenWidth > 0 && ScreenHeight > 0, "the playfield needs a size");
+
+    constexpr int Width() const { return ScreenWidth; }
+    constexpr int Height() const { return ScreenHeight; }
+};
+
+// Player structure holding the simulated state of the circle the user controls.
+// Positions are kept in sub-pixel floats; only drawing snaps them to whole pixels.
+struct Player {
+    float x;     // X position of the circle's center on the screen
+    float y;     // Y position of the circle's center on the screen
+    int radius;  // Radius of the circular player
+    float prevX; // X position before the last step, used for render interpolation
+    float prevY; // Y position before the last step, used for render interpolation
+
+    // Move the player according to the held directions, keeping the whole circle on screen.
+    // 'speed' is defined in pixels per second and 'deltaTime' is the step length in seconds.
+    void Move(int screenWidth, int screenHeight, float speed, float deltaTime, InputMask input) {
+        MoveWithin(RuntimeBounds{screenWidth, screenHeight}, speed, deltaTime, input);
+    }
+
+    // The same rules within RuntimeBounds or FixedBounds.
+    template <typename Bounds>
+    void MoveWithin(const Bounds& bounds, float speed, float deltaTime, InputMask input);
+};
+
+// Axe structure holding the simulated state of one bouncing square obstacle.
+// Games keep their axes in an AxePool; this standalone value is what AxePool::Get() hands out and
+// is handy wherever a single axe is easier to reason about.
+struct Axe {
+    float x;      // X position of the top-left corner of the square axe
+    float y;      // Y position of the top-left corner of the square axe
+    float length; // Side length of the square axe
+    float speedX; // Horizontal movement speed of the axe (pixels per second).
+    float speedY; // Vertical movement speed of the axe (pixels per second).
+    float prevX;  // X position before the last step, used for render interpolation
+    float prevY;  // Y position before the last step, used for render interpolation
+
+    // Move the axe in both directions over 'deltaTime' seconds, bouncing off all screen edges.
+    void Move(int screenWidth, int screenHeight, float deltaTime) {
+        MoveWithin(RuntimeBounds{screenWidth, screenHeight}, deltaTime);
+    }
+
+    // The same rules within RuntimeBounds or FixedBounds.
+    template <typename Bounds>
+    void MoveWithin(const Bounds& bounds, float deltaTime);
+};
+
+// The movement rules live here rather than in simulation.cpp so each kind of bounds gets its own
+// instantiation, with fixed sizes folded in.
+template <typename Bounds>
+void Player::MoveWithin(const Bounds& bounds, float speed, float deltaTime, InputMask input) {
+    // Calculate movement in pixels for this step based on speed and deltaTime.
+    // This is kept fractional: truncating it to whole pixels made the speed depend on the tick
+    // rate and froze the player entirely once a step covered less than one pixel.
+    float movementAmount = speed * deltaTime;
+
+    if (input & INPUT_RIGHT) {
+        x += movementAmount;
+    }
+    if (input & INPUT_LEFT) {
+        x -= movementAmount;
+    }
+    if (input & INPUT_UP) {
+        y -= movementAmount;
+    }
+    if (input & INPUT_DOWN) {
+        y += movementAmount;
+    }
+
+    // The player's center (x, y) must always be within the screen bounds,
+    // considering its radius to prevent drawing outside the window.
+    float minX = static_cast<float>(radius);
+    float minY = static_cast<float>(radius);
+    float maxX = static_cast<float>(bounds.Width() - radius);
+    float maxY = static_cast<float>(bounds.Height() - radius);
+    x = x < minX ? minX : (x > maxX ? maxX : x);
+    y = y < minY ? minY : (y > maxY ? maxY : y);
+}
+
+template <typename Bounds>
+void Axe::MoveWithin(const Bounds& bounds, float deltaTime) {
+    x += speedX * deltaTime; // Update X position based on horizontal speed.
+    y += speedY * deltaTime; // Update Y position based on vertical speed.
+
+    // Reverse horizontal direction if axe hits left or right edge.
+    // The axe's x-coordinate refers to its top-left corner,
+    // so for the right edge we check x + length.
+    if (x + length > bounds.Width() || x < 0) {
+        speedX = -speedX; // Invert horizontal speed to bounce.
+    }
+    // Reverse vertical direction if axe hits top or bottom edge.
+    // Similar logic applies for the bottom edge: y + length.
+    if (y + length > bounds.Height() || y < 0) {
+        speedY = -speedY; // Invert vertical speed to bounce.
+    }
+}
+
+// Check whether a circle overlaps an axis-aligned square with top-left corner (x, y).
+// This is a raylib-free equivalent of CheckCollisionCircleRec, so headless builds get identical results.
+bool CircleOverlapsSquare(float centerX, float centerY, float radius, float x, float y, float length);
+
+// Continuous version of CircleOverlapsSquare for two moving objects.
+// The circle moves in a straight line from (prevCenterX, prevCenterY) to (centerX, centerY) while the
+// square's top-left corner moves from (prevX, prevY) to (x, y) over the same step. Returns true if
+// they touch at any moment of the step, not only at its end, so nothing can pass through anything
+// else between two ticks however fast it moves.
+bool SweptCircleHitsSquare(float prevCenterX, float prevCenterY, float centerX, float centerY, float radius,
+                           float prevX, float prevY, float x, float y, float length);
+
+// Check collision between the player (circle) and the axe (square) over the last step,
+// using both objects' previous and current positions.
+bool CheckCollision(const Player& player, const Axe& axe);
+
+// Small xorshift random number generator. The simulation only ever draws random numbers from an
+// explicitly seeded Rng, so a game is fully determined by its seed and its inputs.
+struct Rng {
+    uint32_t state; // Must never be zero.
+
+    explicit Rng(uint32_t seed = 1u) : state(seed ? seed : 1u) {}
+
+    // Next raw 32-bit value.
+    uint32_t Next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    // Uniform float in [0, 1).
+    float NextFloat() { return (Next() >> 8) * (1.0f / 16777216.0f); }
+};
+
+// The complete state of one game in progress, plus the rules that advance it.
+// A World is a value: copying it copies the whole game, and two Worlds never share state,
+// so any number of them can be simulated side by side.
+struct World {
+    GameConfig config;          // Rules this world plays by. Read on every Reset() and Step().
+    Player player;
+    AxePool axes;               // Every axe in play. The classic game has exactly one.
+    AxeGrid grid;               // Broad phase over 'axes'; lastPairCount is handy for profiling.
+    EcsRegistry obstacles;      // Every other kind of obstacle, as entities (see obstacles.h).
+    int hitAxe;                 // Slot of the axe that hit the player, or -1.
+    Entity hitObstacle;         // Obstacle that hit the player; only valid if hitAxe is -1 and collided.
+
+    int score;                  // Current score based on survival time (1 point per second).
+    float scoreTimer;           // Timer to accumulate time for scoring (in seconds).
+    int lastSpeedIncreaseScore; // Score at which the axe's speed was last increased.
+    bool collided;              // True once the player has been hit; the game is over.
+
+    // What happened during the last Step(), for effects such as sounds.
+    int bounces;                // Axes and obstacles that bounced off an edge.
+    bool speedRamped;           // The axes sped up.
+
+    FrameProfiler* profiler = nullptr; // If set and enabled, Step() reports its phases here.
+    TelemetryStream* telemetry = nullptr; // If set, Step() reports speed ramps and collisions here.
+
+    // Put the world back into the state of a freshly started game with 'axeCount' axes, using the
+    // current 'config'. Changing 'config' between steps takes effect at once for speeds, the ramp
+    // and the caps; sizes and start positions take effect at the next Reset().
+    // The first axe is always the classic one; any extra ("bullet hell") axes are scattered across
+    // the top of the playfield using 'seed', followed by the configured spinning and homing axes.
+    // Storage grows here if needed, never during Step().
+    void Reset(int axeCount = 1, uint32_t seed = 1u);
+
+    // Advance the game by 'deltaTime' seconds with the given input held. The game itself always
+    // passes kTickSeconds (see FixedStepClock); other step lengths are accepted for experiments.
+    // Returns true if the player was hit during this step. Stepping a world that has already
+    // collided does nothing, so callers can keep stepping without checking first.
+    bool Step(float deltaTime, InputMask input);
+};
+
+// Hash of every tuning value that affects how a game plays (plus the tick rate). Replays store it so
+// a recording made with different rules is recognized instead of silently diverging.
+uint32_t SimulationConfigHash(const GameConfig& config);
+
+// Accumulator that turns variable frame times into a whole number of fixed simulation ticks.
+// Each frame, Advance() is told how much real time passed and answers how many kTickSeconds steps
+// to run. The leftover fraction of a tick is kept for the next frame and exposed through Alpha()
+// so the renderer can interpolate between the previous and the current world state.
+struct FixedStepClock {
+    float accumulator = 0.0f; // Real time not yet consumed by simulation ticks (seconds).
+
+    // Returns the number of ticks to run for a frame that took 'frameTime' seconds.
+    // After a long stall (window dragged, debugger break) at most 'maxTicks' are run and the
+    // rest of the backlog is dropped, so a slow frame can never snowball into a "spiral of death".
+    // Fast-forwarding replays pass a scaled frame time and a proportionally larger 'maxTicks'.
+    int Advance(float frameTime, int maxTicks = kMaxCatchUpTicks);
+
+    // Fraction of a tick that has elapsed since the last simulated step, in [0, 1).
+    float Alpha() const { return accumulator / kTickSeconds; }
+
+    // Forget any pending time, e.g. when a new game starts.
+    void Reset() { accumulator = 0.0f; }
+};
+
+#endif // AXE_GAME_SIMULATION_H
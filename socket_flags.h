@@ -0,0 +1,33 @@
+#ifndef AXE_GAME_SOCKET_FLAGS_H
+#define AXE_GAME_SOCKET_FLAGS_H
+
+// Socket settings shared by the TCP clients (leaderboard uploads and telemetry).
+// A peer that closes the connection while we are still sending must make send() fail, not kill the
+// game with SIGPIPE. Linux has a per-call flag for that, macOS and the BSDs a per-socket option, and
+// Windows has no such signal at all, so a client passes kSocketSendFlags to every send() and calls
+// SuppressSigPipe() once on every socket it opens.
+
+#include <cstdint> // intptr_t socket handles.
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#else
+#include <sys/socket.h>
+#endif
+
+#if defined(MSG_NOSIGNAL)
+const int kSocketSendFlags = MSG_NOSIGNAL;
+#else
+const int kSocketSendFlags = 0;
+#endif
+
+inline void SuppressSigPipe(intptr_t sock) {
+#if defined(SO_NOSIGPIPE)
+    int on = 1;
+    setsockopt(static_cast<int>(sock), SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#else
+    (void)sock;
+#endif
+}
+
+#endif // AXE_GAME_SOCKET_FLAGS_H
@@ -0,0 +1,67 @@
+#ifndef AXE_GAME_SPSC_RING_H
+#define AXE_GAME_SPSC_RING_H
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+// The producer only ever stores 'head' and the consumer only ever stores 'tail', so neither side
+// takes a lock or waits on the other: a push is a copy into the slot plus one release store, and a
+// full ring simply refuses the item. Each side also keeps its own copy of the other side's counter
+// and only reloads it when the ring looks full (or empty), so in the common case a push or pop
+// does not touch the cache line the other thread is writing. The counters are padded onto separate
+// cache lines for the same reason.
+//
+// Counters run freely and wrap at 2^32; Capacity is a power of two, so 'counter & (Capacity - 1)'
+// is the slot and 'head - tail' the fill level even across the wrap.
+
+#include <atomic>      // Head and tail counters.
+#include <cstdint>     // uint32_t counters.
+#include <type_traits> // Trivially copyable check.
+
+const int kCacheLineSize = 64;
+
+template <typename T, int Capacity>
+struct SpscRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "items are copied into and out of the slots");
+
+    // Producer side.
+    std::atomic<uint32_t> head{0}; // Items ever pushed.
+    uint32_t cachedTail = 0;       // The producer's last look at 'tail'.
+    char producerPadding[kCacheLineSize - sizeof(std::atomic<uint32_t>) - sizeof(uint32_t)];
+
+    // Consumer side.
+    std::atomic<uint32_t> tail{0}; // Items ever popped.
+    uint32_t cachedHead = 0;       // The consumer's last look at 'head'.
+    char consumerPadding[kCacheLineSize - sizeof(std::atomic<uint32_t>) - sizeof(uint32_t)];
+
+    T slots[Capacity];
+
+    // Producer only. Returns false, leaving the ring unchanged, if it is full.
+    bool TryPush(const T& item) {
+        uint32_t position = head.load(std::memory_order_relaxed);
+        if (position - cachedTail == static_cast<uint32_t>(Capacity)) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (position - cachedTail == static_cast<uint32_t>(Capacity)) {
+                return false;
+            }
+        }
+        slots[position & (Capacity - 1)] = item;
+        head.store(position + 1, std::memory_order_release); // Publishes the slot.
+        return true;
+    }
+
+    // Consumer only. Returns false if the ring is empty.
+    bool TryPop(T& item) {
+        uint32_t position = tail.load(std::memory_order_relaxed);
+        if (position == cachedHead) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (position == cachedHead) {
+                return false;
+            }
+        }
+        item = slots[position & (Capacity - 1)];
+        tail.store(position + 1, std::memory_order_release); // Hands the slot back to the producer.
+        return true;
+    }
+};
+
+#endif // AXE_GAME_SPSC_RING_H
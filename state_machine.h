@@ -0,0 +1,126 @@
+#ifndef AXE_GAME_STATE_MACHINE_H
+#define AXE_GAME_STATE_MACHINE_H
+
+// Stack-based state machine for game screens.
+// Every state is a row of hooks in a table: enter and exit run when it becomes active or goes away,
+// update(deltaTime) runs once per frame while it is on top, and draw runs whenever it is visible.
+// A state can be pushed on top of another as an overlay (a pause screen over the game): the state
+// underneath stops updating but keeps drawing, so the overlay appears on top of a frozen scene.
+//
+// Transitions requested by a hook are only queued. ApplyTransitions() carries them out once the
+// frame's updates and drawing are done, so a state never disappears in the middle of its own
+// update, and a frame always draws the same states it updated.
+//
+// The hooks are plain member function pointers of the context (the Game), and a frame calls only
+// the top state's update and the visible states' draws: an inactive state costs nothing.
+
+template <typename Context>
+struct StateHooks {
+    void (Context::*enter)();                 // Became active (may be null).
+    void (Context::*exit)();                  // Stopped being active (may be null).
+    void (Context::*update)(float deltaTime); // Once per frame while on top (may be null).
+    void (Context::*draw)();                  // Once per frame while visible (may be null).
+    bool overlay;                             // Drawn over the state below instead of replacing it.
+};
+
+enum TransitionKind {
+    TRANSITION_CHANGE, // Leave every state on the stack and enter a new one.
+    TRANSITION_PUSH,   // Enter a state on top of the current one.
+    TRANSITION_POP     // Leave the top state, uncovering the one below.
+};
+
+template <typename Context, int MaxDepth = 4, int MaxQueued = 8>
+struct StateMachine {
+    const StateHooks<Context>* hooks = nullptr; // Indexed by state.
+    int stack[MaxDepth];                        // Active states, bottom first.
+    int depth = 0;
+
+    struct Transition {
+        TransitionKind kind;
+        int state;
+    };
+    Transition queue[MaxQueued]; // Pending transitions in request order.
+    int queued = 0;
+
+    // Set the hook table, indexed by state. It must outlive the machine.
+    void Init(const StateHooks<Context>* table) { hooks = table; }
+
+    // The state on top of the stack, or -1 if there is none.
+    int Top() const { return depth > 0 ? stack[depth - 1] : -1; }
+
+    // True if 'state' is anywhere on the stack, e.g. the game underneath a pause overlay.
+    bool Active(int state) const {
+        for (int i = 0; i < depth; ++i) {
+            if (stack[i] == state) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // True if transitions are waiting for ApplyTransitions().
+    bool Pending() const { return queued > 0; }
+
+    // Queue a transition. Requests beyond MaxQueued in one frame are dropped.
+    void Change(int state) { Queue(TRANSITION_CHANGE, state); }
+    void Push(int state) { Queue(TRANSITION_PUSH, state); }
+    void Pop() { Queue(TRANSITION_POP, -1); }
+
+    // Run the top state's update hook.
+    void Update(Context& context, float deltaTime) {
+        if (depth > 0 && hooks[Top()].update) {
+            (context.*hooks[Top()].update)(deltaTime);
+        }
+    }
+
+    // Draw the visible states: the top one and, under overlays, the ones they cover, bottom first.
+    void Draw(Context& context) {
+        int first = depth - 1;
+        while (first > 0 && hooks[stack[first]].overlay) {
+            --first;
+        }
+        for (int i = first < 0 ? 0 : first; i < depth; ++i) {
+            if (hooks[stack[i]].draw) {
+                (context.*hooks[stack[i]].draw)();
+            }
+        }
+    }
+
+    // Carry out the queued transitions in order, running exit and enter hooks. Returns true if any.
+    // An enter or exit hook may queue further transitions; they are applied in the same call.
+    bool ApplyTransitions(Context& context) {
+        bool applied = false;
+        for (int next = 0; next < queued; ++next) {
+            Transition transition = queue[next];
+            if (transition.kind != TRANSITION_PUSH) {
+                // Change leaves every state, top first; Pop only the top one.
+                while (depth > 0) {
+                    int leaving = stack[--depth];
+                    if (hooks[leaving].exit) {
+                        (context.*hooks[leaving].exit)();
+                    }
+                    if (transition.kind == TRANSITION_POP) {
+                        break;
+                    }
+                }
+            }
+            if (transition.kind != TRANSITION_POP && depth < MaxDepth) {
+                stack[depth++] = transition.state;
+                if (hooks[transition.state].enter) {
+                    (context.*hooks[transition.state].enter)();
+                }
+            }
+            applied = true;
+        }
+        queued = 0;
+        return applied;
+    }
+
+    void Queue(TransitionKind kind, int state) {
+        if (queued < MaxQueued) {
+            queue[queued++] = Transition{kind, state};
+        }
+    }
+};
+
+#endif // AXE_GAME_STATE_MACHINE_H
@@ -0,0 +1,219 @@
+#include "telemetry.h"
+
+#include "socket_flags.h" // No SIGPIPE when the collector hangs up.
+
+#include <chrono>  // Drain interval.
+#include <cstring> // strncmp for the target prefix.
+#include <random>  // Session ids.
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#define CLOSE_SOCKET closesocket
+#else
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#define CLOSE_SOCKET close
+#endif
+
+// How often the worker empties the ring.
+const std::chrono::milliseconds kTelemetryDrainInterval(100);
+// A batch is written once it is this big or this old, whichever comes first.
+const size_t kTelemetryBatchBytes = 16 * 1024;
+const uint64_t kTelemetryFlushNanos = 1000000000ull;
+// Socket send timeout, so a stuck collector cannot stall the worker forever.
+const int kTelemetrySocketTimeoutSeconds = 5;
+
+const intptr_t kNoTelemetrySocket = -1;
+
+// How each event type appears in the output: its name and the names of its fields (null when the
+// event does not use that field).
+struct TelemetryEventFormat {
+    const char* name;
+    const char* value;
+    const char* x;
+    const char* y;
+};
+
+static const TelemetryEventFormat kEventFormats[TELEMETRY_EVENT_COUNT] = {
+    {"session_start", "axes", nullptr, nullptr},
+    {"speed_ramp", "score", "speed_x", "speed_y"},
+    {"collision", "axe", "x", "y"},
+    {"game_over", "score", nullptr, nullptr},
+};
+
+bool TelemetryStream::Start(const char* target) {
+    Stop();
+#if defined(PLATFORM_WEB)
+    (void)target;
+    return false; // No threads, files or sockets that outlive the page.
+#else
+    if (strncmp(target, "tcp:", 4) == 0) {
+        std::string address = target + 4;
+        size_t colon = address.rfind(':');
+        if (colon == std::string::npos || colon == 0 || colon + 1 == address.size()) {
+            return false;
+        }
+        host = address.substr(0, colon);
+        port = address.substr(colon + 1);
+#if defined(_WIN32)
+        WSADATA wsa;
+        if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+            return false;
+        }
+#endif
+    } else {
+        file = fopen(target, "ab");
+        if (!file) {
+            return false;
+        }
+    }
+
+    std::random_device entropy;
+    snprintf(session, sizeof(session), "%08x", static_cast<unsigned>(entropy()));
+    startTime = ProfileNow();
+    stopping = false;
+    active = true;
+    worker = std::thread(&TelemetryStream::RunWorker, this);
+    return true;
+#endif
+}
+
+void TelemetryStream::Stop() {
+    if (!active) {
+        return;
+    }
+    active = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+    CloseSink();
+#if defined(_WIN32)
+    if (!host.empty()) {
+        WSACleanup();
+    }
+#endif
+    host.clear();
+    port.clear();
+}
+
+void TelemetryStream::RunWorker() {
+    std::string batch;
+    uint32_t batchEvents = 0;
+    uint64_t lastWrite = ProfileNow();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait_for(lock, kTelemetryDrainInterval, [this] { return stopping; });
+        // Everything emitted before Stop() set the flag is already in the ring.
+        bool stop = stopping;
+        lock.unlock();
+
+        TelemetryEvent event;
+        while (ring.TryPop(event)) {
+            FormatEvent(event, batch);
+            ++batchEvents;
+        }
+        uint64_t now = ProfileNow();
+        bool due = stop || batch.size() >= kTelemetryBatchBytes || now - lastWrite >= kTelemetryFlushNanos;
+        if (!batch.empty() && due) {
+            if (!Write(batch)) {
+                dropped.fetch_add(batchEvents, std::memory_order_relaxed);
+            }
+            batch.clear();
+            batchEvents = 0;
+            lastWrite = now;
+        }
+        if (stop) {
+            return;
+        }
+        lock.lock();
+    }
+}
+
+void TelemetryStream::FormatEvent(const TelemetryEvent& event, std::string& out) const {
+    if (event.type >= TELEMETRY_EVENT_COUNT) {
+        return;
+    }
+    const TelemetryEventFormat& format = kEventFormats[event.type];
+    char line[256];
+    int size = snprintf(line, sizeof(line), "{\"session\":\"%s\",\"t\":%.6f,\"event\":\"%s\",\"%s\":%d", session,
+                        (event.time - startTime) / 1e9, format.name, format.value, static_cast<int>(event.value));
+    if (format.x) {
+        size += snprintf(line + size, sizeof(line) - size, ",\"%s\":%g", format.x, event.x);
+    }
+    if (format.y) {
+        size += snprintf(line + size, sizeof(line) - size, ",\"%s\":%g", format.y, event.y);
+    }
+    out.append(line, size);
+    out += "}\n";
+}
+
+bool TelemetryStream::Write(const std::string& batch) {
+    if (file) {
+        bool written = fwrite(batch.data(), 1, batch.size(), file) == batch.size();
+        return fflush(file) == 0 && written;
+    }
+
+    // (Re)connect to the collector if the last batch lost the connection.
+    if (sock == kNoTelemetrySocket) {
+        addrinfo hints = {};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* addresses = nullptr;
+        if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0) {
+            return false;
+        }
+        for (addrinfo* address = addresses; address && sock == kNoTelemetrySocket; address = address->ai_next) {
+            intptr_t candidate = static_cast<intptr_t>(socket(address->ai_family, address->ai_socktype,
+                                                              address->ai_protocol));
+            if (candidate == kNoTelemetrySocket) {
+                continue;
+            }
+#if defined(_WIN32)
+            DWORD timeout = kTelemetrySocketTimeoutSeconds * 1000;
+#else
+            timeval timeout = {kTelemetrySocketTimeoutSeconds, 0};
+#endif
+            setsockopt(candidate, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+            SuppressSigPipe(candidate);
+            if (connect(candidate, address->ai_addr, static_cast<int>(address->ai_addrlen)) == 0) {
+                sock = candidate;
+            } else {
+                CLOSE_SOCKET(candidate);
+            }
+        }
+        freeaddrinfo(addresses);
+        if (sock == kNoTelemetrySocket) {
+            return false;
+        }
+    }
+
+    size_t sent = 0;
+    while (sent < batch.size()) {
+        int result = static_cast<int>(send(sock, batch.data() + sent, static_cast<int>(batch.size() - sent),
+                                           kSocketSendFlags));
+        if (result <= 0) {
+            CloseSink(); // Reconnect with the next batch.
+            return false;
+        }
+        sent += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+void TelemetryStream::CloseSink() {
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+    if (sock != kNoTelemetrySocket) {
+        CLOSE_SOCKET(sock);
+        sock = kNoTelemetrySocket;
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef AXE_GAME_TELEMETRY_H
+#define AXE_GAME_TELEMETRY_H
+
+// Gameplay telemetry.
+// The game and the simulation report a handful of events (a session starting, the axes speeding
+// up, the player being hit, a game ending) through Emit(). Emit() stamps the event with the steady
+// clock and copies it into a lock-free single-producer ring (see spsc_ring.h): no lock, no
+// allocation, no system call, so it costs a few nanoseconds and can never stall a frame. If the
+// ring is ever full the event is counted as dropped instead of waiting.
+//
+// A background thread drains the ring a few times per second, turns the events into JSON lines and
+// hands them to the sink in batches: appended to a file, or streamed over TCP to a collector. A
+// sink that fails loses that batch (also counted as dropped) and is retried with the next one;
+// analytics are best effort and never hold up the game. Stop() drains and flushes what is left.
+//
+// One line per event (fields depend on the event; "t" is seconds since Start):
+//   {"session":"5f3a09c1","t":12.504167,"event":"speed_ramp","score":10,"speed_x":165,"speed_y":220}
+//
+// Every Emit() must come from the same thread (the game loop); any thread may read Dropped().
+
+#include <atomic>             // Dropped-event counter.
+#include <condition_variable> // Waking the worker early on Stop().
+#include <cstdint>            // Fixed-width event fields.
+#include <cstdio>             // File sink.
+#include <mutex>              // Guards the stop flag.
+#include <string>             // Sink address and the batch text.
+#include <thread>             // Background writer.
+
+#include "profiler.h"  // ProfileNow() for time stamps.
+#include "spsc_ring.h" // The event queue.
+
+enum TelemetryEventType : uint32_t {
+    TELEMETRY_SESSION_START, // value: axe count.
+    TELEMETRY_SPEED_RAMP,    // value: score; x, y: the first axe's new speed.
+    TELEMETRY_COLLISION,     // value: slot of the axe that hit (-1 for another obstacle); x, y: player.
+    TELEMETRY_GAME_OVER,     // value: final score.
+    TELEMETRY_EVENT_COUNT
+};
+
+// One event as it travels through the ring. 24 bytes, so the default ring holds 96 KiB.
+struct TelemetryEvent {
+    uint64_t time; // ProfileNow() at Emit().
+    uint32_t type; // A TelemetryEventType.
+    int32_t value;
+    float x;
+    float y;
+};
+
+// Events the ring holds between drains. At the worker's drain interval this covers bursts far
+// beyond anything a game produces.
+const int kTelemetryRingSize = 4096;
+
+struct TelemetryStream {
+    // Start writing to 'target': "tcp:HOST:PORT" streams to a collector, anything else is a file
+    // that events are appended to. Returns false if the target is malformed or the file cannot be
+    // opened; the stream then stays off and Emit() does nothing.
+    bool Start(const char* target);
+
+    // Drain and flush every emitted event, then stop the worker. Called by the destructor.
+    void Stop();
+
+    ~TelemetryStream() { Stop(); }
+
+    // True between a successful Start() and Stop().
+    bool Active() const { return active; }
+
+    // Record an event. Never blocks; does nothing if the stream is off.
+    void Emit(TelemetryEventType type, int32_t value = 0, float x = 0.0f, float y = 0.0f) {
+        if (active && !ring.TryPush(TelemetryEvent{ProfileNow(), type, value, x, y})) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Events lost so far, to a full ring or a failed sink.
+    uint32_t Dropped() const { return dropped.load(std::memory_order_relaxed); }
+
+    // Internal state.
+    SpscRing<TelemetryEvent, kTelemetryRingSize> ring;
+    bool active = false;              // Only read and written by the emitting thread.
+    std::atomic<uint32_t> dropped{0};
+    uint64_t startTime = 0;           // ProfileNow() at Start().
+    char session[9] = {};             // Random id that tags every line of this run.
+    FILE* file = nullptr;             // File sink, or null.
+    std::string host;                 // TCP sink, if 'file' is null.
+    std::string port;
+    intptr_t sock = -1;               // Connected collector socket, or -1 until (re)connected.
+
+    std::thread worker;
+    std::mutex mutex;                 // Guards 'stopping'.
+    std::condition_variable wake;     // Signalled by Stop().
+    bool stopping = false;
+
+    void RunWorker();
+    void FormatEvent(const TelemetryEvent& event, std::string& out) const;
+    bool Write(const std::string& batch);
+    void CloseSink();
+};
+
+#endif // AXE_GAME_TELEMETRY_H
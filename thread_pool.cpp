@@ -0,0 +1,105 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+        if (threadCount <= 0) {
+            threadCount = 1; // hardware_concurrency() may report 0 when it cannot tell.
+        }
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        workers.emplace_back(new Worker());
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        threads.emplace_back(&ThreadPool::RunWorker, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::Submit(Task task) {
+    int target = static_cast<int>(nextWorker++ % workers.size());
+    pending++;
+    {
+        std::lock_guard<std::mutex> lock(workers[target]->mutex);
+        workers[target]->tasks.push_back(std::move(task));
+    }
+    queued++;
+    {
+        // Taking the sleep lock orders this notify after any worker's "nothing queued" check.
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_one();
+}
+
+void ThreadPool::Wait() {
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    finished.wait(lock, [this] { return pending.load() == 0; });
+}
+
+void ThreadPool::ParallelFor(long long count, long long grain,
+                             const std::function<void(long long, long long, int)>& body) {
+    if (grain < 1) {
+        grain = 1;
+    }
+    for (long long begin = 0; begin < count; begin += grain) {
+        long long end = begin + grain < count ? begin + grain : count;
+        Submit([&body, begin, end](int worker) { body(begin, end, worker); });
+    }
+    Wait();
+}
+
+bool ThreadPool::TryTake(int self, Task& task) {
+    // Own deque first, newest task (still warm in cache)...
+    {
+        Worker& own = *workers[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued--;
+            return true;
+        }
+    }
+    // ...then steal the oldest task from the next worker that has one.
+    int count = static_cast<int>(workers.size());
+    for (int offset = 1; offset < count; ++offset) {
+        Worker& victim = *workers[(self + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::RunWorker(int self) {
+    for (;;) {
+        Task task;
+        if (TryTake(self, task)) {
+            task(self);
+            if (--pending == 0) {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                finished.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef AXE_GAME_THREAD_POOL_H
+#define AXE_GAME_THREAD_POOL_H
+
+// Small work-stealing thread pool for the batch tools.
+// Every worker owns a task deque. A worker takes its newest task from the back of its own deque and,
+// when that runs dry, steals the oldest task from the front of another worker's deque. Owners and
+// thieves work on opposite ends, so they rarely contend, and uneven tasks (short and long games)
+// balance out across the cores automatically.
+
+#include <atomic>             // Pending/queued task counters.
+#include <condition_variable> // Sleeping idle workers and waiting for completion.
+#include <deque>              // Per-worker task deques.
+#include <functional>         // Type-erased tasks.
+#include <memory>             // Stable addresses for per-worker state.
+#include <mutex>              // Per-deque locks.
+#include <thread>             // Worker threads.
+#include <vector>             // Worker storage.
+
+struct ThreadPool {
+    // A task receives the index of the worker running it, in [0, Size()), so it can use per-worker
+    // state without any locking.
+    typedef std::function<void(int worker)> Task;
+
+    // Start 'threadCount' workers; 0 means one per hardware thread.
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int Size() const { return static_cast<int>(threads.size()); }
+
+    // Queue a task. Tasks are spread round-robin over the worker deques.
+    void Submit(Task task);
+
+    // Block until every submitted task has finished.
+    void Wait();
+
+    // Run body(begin, end, worker) over [0, count) in chunks of at most 'grain' items and wait for it.
+    void ParallelFor(long long count, long long grain, const std::function<void(long long, long long, int)>& body);
+
+    // Internal state.
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    std::mutex sleepMutex;               // Guards sleeping/waking and 'stopping'.
+    std::condition_variable wake;        // Signalled when tasks are queued or the pool stops.
+    std::condition_variable finished;    // Signalled when 'pending' drops to zero.
+    std::atomic<int> queued{0};          // Tasks sitting in deques.
+    std::atomic<int> pending{0};         // Tasks submitted but not yet finished.
+    std::atomic<unsigned> nextWorker{0}; // Round-robin cursor for Submit().
+    bool stopping = false;
+
+    bool TryTake(int self, Task& task);
+    void RunWorker(int self);
+};
+
+#endif // AXE_GAME_THREAD_POOL_H
@@ -0,0 +1,191 @@
+#include "versus.h"
+
+#include "build_profile.h" // Fixed playfield and player speed in specialized builds.
+
+#include <cmath>   // fabsf for the speed caps.
+#include <cstring> // memcpy for snapshots.
+
+void VersusReset(VersusState& state, const GameConfig& config, int axeCount, uint32_t seed) {
+    state = VersusState{};
+    const float startY = config.screenHeight / 2;
+    for (int side = 0; side < kVersusPlayers; ++side) {
+        const float startX = config.screenWidth * (side + 1) / 3;
+        state.players[side] = {startX, startY, config.playerRadius, startX, startY};
+    }
+
+    // Same layout as World::Reset: the classic axe, then bullet hell axes along the top band.
+    axeCount = axeCount < 1 ? 1 : (axeCount > kVersusMaxAxes ? kVersusMaxAxes : axeCount);
+    const float axeLength = static_cast<float>(config.axeLength);
+    float startAxeX = static_cast<float>(config.axeStartX);
+    float startAxeY = static_cast<float>(config.axeStartY);
+    state.axes[0] = {startAxeX, startAxeY, axeLength, config.axeStartSpeedX, config.axeStartSpeedY,
+                     startAxeX, startAxeY};
+    Rng rng(seed);
+    for (int i = 1; i < axeCount; ++i) {
+        float spawnX = rng.NextFloat() * (config.screenWidth - config.axeLength);
+        float spawnY = rng.NextFloat() * (config.bulletHellSpawnHeight - config.axeLength);
+        float speedX = (rng.Next() & 1) ? config.axeStartSpeedX : -config.axeStartSpeedX;
+        float speedY = (rng.Next() & 1) ? config.axeStartSpeedY : -config.axeStartSpeedY;
+        state.axes[i] = {spawnX, spawnY, axeLength, speedX, speedY, spawnX, spawnY};
+    }
+    state.axeCount = axeCount;
+    state.overTick = -1;
+}
+
+bool VersusStep(VersusState& state, const GameConfig& config, const InputMask inputs[kVersusPlayers]) {
+    if (state.overTick >= 0) {
+        ++state.tick; // Time still passes, so both sides keep exchanging (and confirming) inputs.
+        return true;
+    }
+
+    const auto bounds = BuildProfile::Bounds(config); // Constants in fixed-profile builds.
+    for (int side = 0; side < kVersusPlayers; ++side) {
+        Player& player = state.players[side];
+        player.prevX = player.x;
+        player.prevY = player.y;
+        player.MoveWithin(bounds, BuildProfile::PlayerSpeed(config), kTickSeconds, inputs[side]);
+    }
+    for (int i = 0; i < state.axeCount; ++i) {
+        Axe& axe = state.axes[i];
+        axe.prevX = axe.x;
+        axe.prevY = axe.y;
+        axe.MoveWithin(bounds, kTickSeconds);
+    }
+
+    // Scoring and the difficulty ramp follow World::Step.
+    state.scoreTimer += kTickSeconds;
+    if (state.scoreTimer >= 1.0f) {
+        state.score += 1;
+        state.scoreTimer -= 1.0f;
+    }
+    if (state.score > state.lastSpeedIncreaseScore && state.score % config.speedRampInterval == 0) {
+        for (int i = 0; i < state.axeCount; ++i) {
+            Axe& axe = state.axes[i];
+            if (fabsf(axe.speedX) < config.maxAxeSpeedX) {
+                axe.speedX *= config.speedRampFactor;
+            }
+            if (fabsf(axe.speedY) < config.maxAxeSpeedY) {
+                axe.speedY *= config.speedRampFactor;
+            }
+        }
+        state.lastSpeedIncreaseScore = state.score;
+    }
+
+    // At most a few dozen pairs: no broad phase needed.
+    bool over = false;
+    for (int side = 0; side < kVersusPlayers; ++side) {
+        for (int i = 0; i < state.axeCount && !state.hit[side]; ++i) {
+            state.hit[side] = CheckCollision(state.players[side], state.axes[i]) ? 1 : 0;
+        }
+        over = over || state.hit[side];
+    }
+    if (over) {
+        state.overTick = state.tick;
+    }
+    ++state.tick;
+    return over;
+}
+
+uint32_t VersusChecksum(const VersusState& state) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&state);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(state); ++i) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+void RollbackSession::Start(const GameConfig& rules, int axeCount, uint32_t seed, int side) {
+    config = rules;
+    localSide = side;
+    VersusReset(state, config, axeCount, seed);
+    memset(inputs, 0, sizeof(inputs));
+    confirmedRemote = -1;
+    rollbackFrom = -1;
+    rollbacks = 0;
+    resimulatedTicks = 0;
+    deepestRollback = 0;
+}
+
+void RollbackSession::AddRemoteInput(int tick, InputMask input) {
+    // Further ahead than that would overwrite ring entries still in use; it will be sent again.
+    if (tick != confirmedRemote + 1 || tick >= state.tick + kRollbackRing - kRollbackTicks - 1) {
+        return;
+    }
+    InputMask& slot = inputs[1 - localSide][tick % kRollbackRing];
+    if (tick < state.tick && slot != input && (rollbackFrom < 0 || tick < rollbackFrom)) {
+        rollbackFrom = tick; // Simulated with a wrong prediction.
+    }
+    slot = input;
+    confirmedRemote = tick;
+}
+
+InputMask RollbackSession::RemoteInputFor(int tick) const {
+    if (tick <= confirmedRemote) {
+        return inputs[1 - localSide][tick % kRollbackRing];
+    }
+    // Predict that the remote player still holds whatever they held last.
+    if (confirmedRemote < 0) {
+        return INPUT_NONE;
+    }
+    return inputs[1 - localSide][confirmedRemote % kRollbackRing];
+}
+
+void RollbackSession::Simulate() {
+    int slot = state.tick % kRollbackRing;
+    memcpy(&snapshots[slot], &state, sizeof(state));
+    InputMask stepInputs[kVersusPlayers];
+    stepInputs[localSide] = inputs[localSide][slot];
+    stepInputs[1 - localSide] = RemoteInputFor(state.tick);
+    inputs[1 - localSide][slot] = stepInputs[1 - localSide]; // Remember the prediction to check it later.
+    VersusStep(state, config, stepInputs);
+}
+
+bool RollbackSession::Advance(InputMask localInput) {
+    if (state.tick > confirmedRemote + kRollbackTicks) {
+        return false; // Too far ahead of the other side to roll back safely: wait for its inputs.
+    }
+    if (rollbackFrom >= 0) {
+        int present = state.tick;
+        int depth = present - rollbackFrom;
+        memcpy(&state, &snapshots[rollbackFrom % kRollbackRing], sizeof(state));
+        while (state.tick < present) {
+            Simulate();
+        }
+        ++rollbacks;
+        resimulatedTicks += depth;
+        deepestRollback = depth > deepestRollback ? depth : deepestRollback;
+        rollbackFrom = -1;
+    }
+    inputs[localSide][state.tick % kRollbackRing] = localInput;
+    Simulate();
+    return true;
+}
+
+bool RollbackSession::ConfirmedChecksum(int& tick, uint32_t& checksum) const {
+    // The state before tick 'tick' is final once every input before it is confirmed and any
+    // pending correction has been replayed.
+    int last = confirmedRemote < state.tick - 1 ? confirmedRemote : state.tick - 1;
+    if (last < 0 || rollbackFrom >= 0) {
+        return false;
+    }
+    tick = last + 1;
+    if (tick == state.tick) {
+        checksum = VersusChecksum(state);
+        return true;
+    }
+    if (tick <= state.tick - kRollbackRing) {
+        return false;
+    }
+    checksum = VersusChecksum(snapshots[tick % kRollbackRing]);
+    return true;
+}
+
+bool RollbackSession::MatchesRemoteChecksum(int tick, uint32_t checksum) const {
+    bool final = tick - 1 <= confirmedRemote && tick <= state.tick && (rollbackFrom < 0 || rollbackFrom >= tick);
+    if (!final || tick <= state.tick - kRollbackRing || tick < 1) {
+        return true; // Not comparable (yet, or anymore).
+    }
+    const VersusState& ours = tick == state.tick ? state : snapshots[tick % kRollbackRing];
+    return VersusChecksum(ours) == checksum;
+}
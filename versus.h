@@ -0,0 +1,105 @@
+#ifndef AXE_GAME_VERSUS_H
+#define AXE_GAME_VERSUS_H
+
+// Two-player versus mode with rollback.
+// Two players dodge one shared set of axes; whoever is hit first loses, and a hit on the same tick
+// is a draw. Each side runs the whole simulation. The local player's input is used the moment it is
+// pressed, and the remote player's input for ticks that have not arrived yet is predicted (its last
+// known input is assumed to still be held). When the real input turns out to differ, the session
+// rolls back to the snapshot taken before that tick and silently re-simulates up to the present, so
+// neither player ever waits for the network.
+//
+// That only works because the versus state is small and a plain value: VersusState is trivially
+// copyable, a snapshot is one memcpy, and re-simulating a few dozen ticks of two circles and a
+// handful of axes costs microseconds. It reuses the single-player rules (Player::Move, Axe::Move,
+// CheckCollision and the same difficulty ramp) but keeps its axes in a fixed array instead of an
+// AxePool, and has no ECS obstacles, so that it stays a plain value.
+//
+// Nothing here touches the network; see versus_net.h for the connection that feeds a session.
+
+#include <cstdint>     // Fixed-width fields.
+#include <type_traits> // Trivially copyable check.
+
+#include "simulation.h" // Player, Axe, GameConfig, InputMask and the tick rate.
+
+const int kVersusPlayers = 2;
+const int kVersusMaxAxes = 64;
+
+// Everything that changes during a versus game. All fields are 32 bits wide, so there is no
+// padding and the bytes (which the checksum covers) are fully determined by the values.
+struct VersusState {
+    int32_t tick;                    // Next tick to simulate.
+    Player players[kVersusPlayers];  // Side 0 starts on the left, side 1 on the right.
+    Axe axes[kVersusMaxAxes];
+    int32_t axeCount;
+    int32_t score;                   // Shared survival time in seconds.
+    float scoreTimer;
+    int32_t lastSpeedIncreaseScore;
+    int32_t hit[kVersusPlayers];     // 1 once that player has been hit.
+    int32_t overTick;                // Tick on which the game ended, or -1 while it runs.
+};
+static_assert(std::is_trivially_copyable<VersusState>::value, "snapshots are taken with memcpy");
+
+// Start a versus game with 'axeCount' axes (clamped to 1..kVersusMaxAxes) laid out from 'seed'
+// exactly like World::Reset lays out bullet hell axes.
+void VersusReset(VersusState& state, const GameConfig& config, int axeCount, uint32_t seed);
+
+// Advance one tick with each side's held input. Returns true once the game is over; stepping a
+// finished game does nothing.
+bool VersusStep(VersusState& state, const GameConfig& config, const InputMask inputs[kVersusPlayers]);
+
+// FNV-1a hash of the whole state, for comparing the two sides' simulations.
+uint32_t VersusChecksum(const VersusState& state);
+
+// Deepest rollback. A side never runs more than this many ticks past the newest input it has from
+// the other side, so every misprediction can still be corrected from a stored snapshot.
+const int kRollbackTicks = 32;
+// Ring size for snapshots and inputs: covers the rollback window behind the present, plus inputs
+// the other side has already sent for ticks this side has not reached yet.
+const int kRollbackRing = 128;
+
+struct RollbackSession {
+    GameConfig config;                                // Rules, fixed for the whole game.
+    int localSide = 0;
+    VersusState state = {};                           // The present.
+    VersusState snapshots[kRollbackRing];             // State before tick t, at t % kRollbackRing.
+    InputMask inputs[kVersusPlayers][kRollbackRing];  // Input each side used on tick t.
+    int confirmedRemote = -1;                         // Remote inputs are known through this tick.
+    int rollbackFrom = -1;                            // Earliest mispredicted tick, or -1.
+
+    // Statistics.
+    int rollbacks = 0;
+    int resimulatedTicks = 0;
+    int deepestRollback = 0;
+
+    // Start a game. Both sides must pass the same config, axe count and seed.
+    void Start(const GameConfig& rules, int axeCount, uint32_t seed, int side);
+
+    // Record the remote side's input for 'tick'. Inputs must arrive in tick order; duplicates and
+    // inputs after a gap are ignored (the sender repeats everything not yet acknowledged).
+    void AddRemoteInput(int tick, InputMask input);
+
+    // Correct any misprediction, then simulate the present tick with 'localInput'. Returns false,
+    // without simulating, if this side is kRollbackTicks ahead of the remote inputs and must wait.
+    bool Advance(InputMask localInput);
+
+    // Input this side used on 'tick'; must be within the ring (recent ticks only).
+    InputMask LocalInput(int tick) const { return inputs[localSide][tick % kRollbackRing]; }
+
+    // True if the game ended on a tick whose inputs are all confirmed, so no rollback can undo it.
+    bool ConfirmedOver() const { return state.overTick >= 0 && state.overTick <= confirmedRemote; }
+
+    // Checksum of the state after the newest fully confirmed tick (so it can never change again),
+    // for the other side to compare. Returns false if there is no such state in the ring yet.
+    bool ConfirmedChecksum(int& tick, uint32_t& checksum) const;
+
+    // Compare the remote side's checksum for the state before 'tick' with ours. Returns false on a
+    // mismatch (the simulations diverged); true if they agree or ours is not final or stored.
+    bool MatchesRemoteChecksum(int tick, uint32_t checksum) const;
+
+    // Internal helpers.
+    InputMask RemoteInputFor(int tick) const;
+    void Simulate();
+};
+
+#endif // AXE_GAME_VERSUS_H
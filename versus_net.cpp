@@ -0,0 +1,315 @@
+#include "versus_net.h"
+
+#include <chrono>  // Handshake resends and the timeout.
+#include <cstring> // memcpy/memcmp for the wire format.
+#include <string>  // Address parsing.
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#define CLOSE_SOCKET closesocket
+typedef int SocketLength;
+#else
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define CLOSE_SOCKET close
+typedef socklen_t SocketLength;
+#endif
+
+const VersusSocket kNoSocket = static_cast<VersusSocket>(-1);
+const double kHelloInterval = 0.1;      // Seconds between HELLOs while joining.
+const double kVersusTimeoutSeconds = 5.0;
+const int kMaxPacketSize = 512;          // Far more than the largest INPUTS packet.
+const int kYieldThreshold = 2;           // Ticks of lead over the other side before easing off.
+
+enum VersusPacketType : uint8_t { PACKET_HELLO = 1, PACKET_START = 2, PACKET_INPUTS = 3 };
+
+static double Now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Little-endian packet writer and reader over a fixed buffer.
+struct PacketWriter {
+    unsigned char data[kMaxPacketSize];
+    int size = 0;
+
+    void U8(uint32_t value) { data[size++] = static_cast<unsigned char>(value); }
+    void U16(uint32_t value) {
+        U8(value);
+        U8(value >> 8);
+    }
+    void U32(uint32_t value) {
+        U16(value);
+        U16(value >> 16);
+    }
+    void Header(VersusPacketType type) {
+        memcpy(data, "AXVS", 4);
+        size = 4;
+        U8(kVersusVersion);
+        U8(type);
+    }
+};
+
+struct PacketReader {
+    const unsigned char* data;
+    int size;
+    int offset = 0;
+    bool ok = true; // False once a read ran past the end.
+
+    uint32_t U8() {
+        if (offset + 1 > size) {
+            ok = false;
+            return 0;
+        }
+        return data[offset++];
+    }
+    uint32_t U16() {
+        uint32_t low = U8();
+        return low | (U8() << 8);
+    }
+    uint32_t U32() {
+        uint32_t low = U16();
+        return low | (U16() << 16);
+    }
+};
+
+bool VersusPeer::OpenSocket(int family, int port) {
+#if defined(_WIN32)
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+        return false;
+    }
+#endif
+    sock = static_cast<VersusSocket>(socket(family, SOCK_DGRAM, IPPROTO_UDP));
+    if (sock == kNoSocket) {
+        return false;
+    }
+#if defined(_WIN32)
+    u_long nonBlocking = 1;
+    ioctlsocket(sock, FIONBIO, &nonBlocking);
+#else
+    fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+#endif
+    if (port > 0) {
+        sockaddr_in local = {};
+        local.sin_family = AF_INET;
+        local.sin_addr.s_addr = htonl(INADDR_ANY);
+        local.sin_port = htons(static_cast<uint16_t>(port));
+        if (bind(sock, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0) {
+            Close();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool VersusPeer::Host(int port, const GameConfig& rules, int axes, uint32_t gameSeed) {
+    Close();
+    if (port <= 0 || port > 65535 || !OpenSocket(AF_INET, port)) {
+        return false;
+    }
+    config = rules;
+    configHash = SimulationConfigHash(rules);
+    hosting = true;
+    seed = gameSeed;
+    axeCount = axes < 1 ? 1 : (axes > kVersusMaxAxes ? kVersusMaxAxes : axes);
+    status = VERSUS_WAITING;
+    return true;
+}
+
+bool VersusPeer::Join(const char* address, const GameConfig& rules) {
+    Close();
+    std::string text = address;
+    size_t colon = text.rfind(':');
+    if (colon == std::string::npos || colon == 0 || colon + 1 == text.size()) {
+        return false;
+    }
+    std::string host = text.substr(0, colon);
+    std::string port = text.substr(colon + 1);
+    if (!OpenSocket(AF_INET, 0)) {
+        return false;
+    }
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* found = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &found) != 0 || !found) {
+        Close();
+        return false;
+    }
+    memcpy(peerAddress, found->ai_addr, found->ai_addrlen);
+    peerAddressSize = static_cast<int>(found->ai_addrlen);
+    freeaddrinfo(found);
+
+    config = rules;
+    configHash = SimulationConfigHash(rules);
+    hosting = false;
+    status = VERSUS_WAITING;
+    lastHeard = Now(); // The timeout also covers a host that never answers.
+    lastHello = 0.0;
+    return true;
+}
+
+void VersusPeer::Close() {
+    if (sock != kNoSocket) {
+        CLOSE_SOCKET(sock);
+        sock = kNoSocket;
+#if defined(_WIN32)
+        WSACleanup();
+#endif
+    }
+    status = VERSUS_OFF;
+    peerAddressSize = 0;
+    remoteWants = 0;
+    remoteTick = -1;
+    remoteAdvantage = 0;
+}
+
+void VersusPeer::SendTo(const unsigned char* data, int size) {
+    sendto(sock, reinterpret_cast<const char*>(data), size, 0, reinterpret_cast<const sockaddr*>(peerAddress),
+           static_cast<SocketLength>(peerAddressSize));
+}
+
+void VersusPeer::Receive() {
+    if (sock == kNoSocket) {
+        return;
+    }
+    unsigned char buffer[kMaxPacketSize];
+    for (;;) {
+        unsigned char from[sizeof(peerAddress)];
+        SocketLength fromSize = sizeof(from);
+        int size = static_cast<int>(recvfrom(sock, reinterpret_cast<char*>(buffer), sizeof(buffer), 0,
+                                             reinterpret_cast<sockaddr*>(from), &fromSize));
+        if (size < 0) {
+            break; // Nothing more pending (or a transient error; the next frame tries again).
+        }
+        PacketReader packet = {buffer, size};
+        if (size < 6 || memcmp(buffer, "AXVS", 4) != 0 || buffer[4] != kVersusVersion) {
+            continue;
+        }
+        packet.offset = 6;
+        uint8_t type = buffer[5];
+        bool fromPeer = peerAddressSize == static_cast<int>(fromSize) && memcmp(from, peerAddress, fromSize) == 0;
+
+        if (type == PACKET_HELLO && hosting) {
+            uint32_t theirHash = packet.U32();
+            if (!packet.ok || (peerAddressSize != 0 && !fromPeer)) {
+                continue; // Malformed, or someone else while a game is on.
+            }
+            if (peerAddressSize == 0 && theirHash == configHash) {
+                memcpy(peerAddress, from, fromSize);
+                peerAddressSize = static_cast<int>(fromSize);
+                session.Start(config, axeCount, seed, 0);
+                status = VERSUS_PLAYING;
+                lastHeard = Now();
+            }
+            // Answer every HELLO, also a rejected one, so the joiner learns why it cannot play.
+            PacketWriter reply;
+            reply.Header(PACKET_START);
+            reply.U32(configHash);
+            reply.U32(seed);
+            reply.U16(static_cast<uint32_t>(axeCount));
+            sendto(sock, reinterpret_cast<const char*>(reply.data), reply.size, 0,
+                   reinterpret_cast<const sockaddr*>(from), fromSize);
+        } else if (type == PACKET_START && !hosting && fromPeer) {
+            uint32_t theirHash = packet.U32();
+            uint32_t theirSeed = packet.U32();
+            int theirAxes = static_cast<int>(packet.U16());
+            if (!packet.ok || status != VERSUS_WAITING) {
+                continue;
+            }
+            if (theirHash != configHash) {
+                status = VERSUS_REJECTED;
+                continue;
+            }
+            seed = theirSeed;
+            axeCount = theirAxes;
+            session.Start(config, axeCount, seed, 1);
+            status = VERSUS_PLAYING;
+            lastHeard = Now();
+        } else if (type == PACKET_INPUTS && fromPeer && status == VERSUS_PLAYING) {
+            int wants = static_cast<int>(packet.U32());
+            int advantage = static_cast<int32_t>(packet.U32());
+            int checkTick = static_cast<int>(packet.U32());
+            uint32_t checksum = packet.U32();
+            int first = static_cast<int>(packet.U32());
+            int count = static_cast<int>(packet.U8());
+            if (!packet.ok || packet.offset + count > size) {
+                continue;
+            }
+            lastHeard = Now();
+            remoteWants = wants > remoteWants ? wants : remoteWants;
+            remoteAdvantage = advantage;
+            for (int i = 0; i < count; ++i) {
+                session.AddRemoteInput(first + i, buffer[packet.offset + i]);
+            }
+            remoteTick = first + count - 1 > remoteTick ? first + count - 1 : remoteTick;
+            if (!session.MatchesRemoteChecksum(checkTick, checksum)) {
+                status = VERSUS_DESYNCED;
+            }
+        }
+    }
+
+    bool waitingOnPeer = status == VERSUS_PLAYING || (status == VERSUS_WAITING && !hosting);
+    if (waitingOnPeer && Now() - lastHeard > kVersusTimeoutSeconds) {
+        status = VERSUS_TIMED_OUT;
+    }
+}
+
+void VersusPeer::Send() {
+    if (sock == kNoSocket || peerAddressSize == 0) {
+        return;
+    }
+    PacketWriter packet;
+    if (status == VERSUS_WAITING && !hosting) {
+        double now = Now();
+        if (now - lastHello >= kHelloInterval) {
+            packet.Header(PACKET_HELLO);
+            packet.U32(configHash);
+            SendTo(packet.data, packet.size);
+            lastHello = now;
+        }
+        return;
+    }
+    if (status != VERSUS_PLAYING) {
+        return;
+    }
+
+    // Every input the other side has not acknowledged, oldest first; the ring bounds how far back
+    // that can go, and rollback keeps it well inside one packet.
+    int present = session.state.tick;
+    int first = remoteWants;
+    int oldest = present - kRollbackRing + 1;
+    first = first < oldest ? oldest : first;
+    int count = present - first;
+    count = count > 255 ? 255 : (count < 0 ? 0 : count);
+    int checkTick = 0;
+    uint32_t checksum = 0;
+    session.ConfirmedChecksum(checkTick, checksum);
+
+    packet.Header(PACKET_INPUTS);
+    packet.U32(static_cast<uint32_t>(session.confirmedRemote + 1));
+    packet.U32(static_cast<uint32_t>(present - (remoteTick + 1)));
+    packet.U32(static_cast<uint32_t>(checkTick));
+    packet.U32(checksum);
+    packet.U32(static_cast<uint32_t>(first));
+    packet.U8(static_cast<uint32_t>(count));
+    for (int i = 0; i < count; ++i) {
+        packet.U8(session.LocalInput(first + i));
+    }
+    SendTo(packet.data, packet.size);
+}
+
+int VersusPeer::TicksToYield() const {
+    if (status != VERSUS_PLAYING) {
+        return 0;
+    }
+    // Both sides see the other about one trip behind, so compare the two views: half the
+    // difference is how far this side is really ahead.
+    int localAdvantage = session.state.tick - (remoteTick + 1);
+    int lead = (localAdvantage - remoteAdvantage) / 2;
+    return lead >= kYieldThreshold ? 1 : 0;
+}
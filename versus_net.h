@@ -0,0 +1,88 @@
+#ifndef AXE_GAME_VERSUS_NET_H
+#define AXE_GAME_VERSUS_NET_H
+
+// Peer-to-peer connection for the versus mode.
+// One side hosts on a UDP port and the other joins it. Once joined, the host picks the seed and
+// axe count, and both sides start the same RollbackSession (see versus.h). From then on each
+// side sends one small packet per frame. The packet repeats every local input the other side
+// has not acknowledged yet, so a lost packet costs nothing but a slightly later correction and
+// nothing has to be retransmitted on a timer. It also carries:
+//   - how far ahead the sender thinks it is, so the side that is ahead can ease off;
+//   - a checksum of the sender's newest confirmed state, so a desync is caught instead of
+//     silently playing two different games.
+// Sockets are non-blocking and everything happens inside Receive() and Send(), so the frame never
+// waits on the network.
+//
+// Packets (all integers little-endian):
+//   "AXVS"  magic, u8 version (kVersusVersion), u8 type
+//   HELLO   joiner to host, repeated until START arrives: u32 config hash
+//   START   host to joiner, the answer to every HELLO: u32 config hash, u32 seed, u16 axe count
+//   INPUTS  both ways, once per frame: u32 next tick wanted from the receiver, i32 sender's tick
+//           advantage, u32 checksum tick, u32 checksum, u32 first tick, u8 count, then that many
+//           input bytes
+
+#include <cstdint> // Wire fields.
+
+#include "versus.h" // RollbackSession.
+
+#if defined(_WIN32)
+typedef uintptr_t VersusSocket; // A SOCKET, without pulling winsock2.h into every includer.
+#else
+typedef int VersusSocket;
+#endif
+
+const uint8_t kVersusVersion = 1;
+
+enum VersusStatus {
+    VERSUS_OFF,        // No connection.
+    VERSUS_WAITING,    // Hosting, or joining, and no game yet.
+    VERSUS_PLAYING,    // 'session' is running.
+    VERSUS_REJECTED,   // The other side plays by different rules (config hash mismatch).
+    VERSUS_TIMED_OUT,  // Nothing heard from the other side for kVersusTimeoutSeconds.
+    VERSUS_DESYNCED    // The two simulations diverged; the game cannot continue.
+};
+
+struct VersusPeer {
+    // Wait for a player to join on UDP 'port'; the game uses 'axeCount' axes laid out from 'seed'.
+    bool Host(int port, const GameConfig& config, int axeCount, uint32_t seed);
+
+    // Join the game hosted at "host:port". Returns false if the address is malformed or unknown.
+    bool Join(const char* address, const GameConfig& config);
+
+    // Close the connection.
+    void Close();
+
+    ~VersusPeer() { Close(); }
+
+    // Process every packet that arrived since the last call. Once per frame, before the ticks.
+    void Receive();
+
+    // Send this frame's packet. Once per frame, after the ticks.
+    void Send();
+
+    // Ticks to skip this frame so the side that is ahead lets the other catch up. Skipping a tick
+    // now and then is far less noticeable than the stalls of running too far ahead.
+    int TicksToYield() const;
+
+    // Internal state.
+    VersusStatus status = VERSUS_OFF;
+    RollbackSession session;
+    GameConfig config;
+    bool hosting = false;
+    uint32_t configHash = 0;
+    uint32_t seed = 0;
+    int axeCount = 1;
+    VersusSocket sock = static_cast<VersusSocket>(-1);
+    unsigned char peerAddress[128] = {};   // sockaddr_storage of the other side.
+    int peerAddressSize = 0;               // 0 until the host has heard from a joiner.
+    int remoteWants = 0;                   // First local tick the other side has not received yet.
+    int remoteTick = -1;                   // Newest tick the other side has sent an input for.
+    int remoteAdvantage = 0;               // How far ahead the other side thinks it is.
+    double lastHeard = 0.0;                // When a packet last arrived (seconds, steady clock).
+    double lastHello = 0.0;                // When the joiner last sent HELLO.
+
+    bool OpenSocket(int family, int port);
+    void SendTo(const unsigned char* data, int size);
+};
+
+#endif // AXE_GAME_VERSUS_NET_H